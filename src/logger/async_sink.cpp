@@ -0,0 +1,77 @@
+#include "async_sink.hpp"
+
+#include "utility.hpp"
+
+namespace logger {
+    AsyncSink::AsyncSink(std::unique_ptr<ILogSink> sink, size_t queue_capacity) :
+        AsyncSink(std::move(sink), drop_newest_options(queue_capacity)) {}
+
+    AsyncSink::AsyncSink(std::unique_ptr<ILogSink> sink, const QueueOptions &queue_options) :
+        sink_(std::move(sink)),
+        queue_(
+                queue_options, [this](std::vector<LogRecord> &lines, size_t count) { write_lines(lines, count); },
+                [this](LogRecord &&line) { write_evicted(std::move(line)); },
+                [this](std::string_view summary) { write_drop_summary(summary); }) {
+        queue_.start();
+    }
+
+    AsyncSink::~AsyncSink() { queue_.stop(); }
+
+    void AsyncSink::write(std::string_view message) {
+        queue_.push(LogRecord(message, LogLevel::INFO));
+        queue_.notify();
+    }
+
+    void AsyncSink::write_batch(const std::vector<SinkMessage> &messages) {
+        for (const auto &message: messages) {
+            queue_.push(LogRecord(message.text, message.level, message.timestamp));
+        }
+        queue_.notify();
+    }
+
+    void AsyncSink::flush() {
+        queue_.flush();
+
+        if (sink_) {
+            sink_->flush();
+        }
+    }
+
+    bool AsyncSink::is_valid() const { return sink_ && sink_->is_valid(); }
+
+    size_t AsyncSink::dropped_count() const { return queue_.dropped().total(); }
+
+    QueueOptions AsyncSink::drop_newest_options(size_t queue_capacity) {
+        QueueOptions options(queue_capacity);
+        options.policy = OverflowPolicy::DROP_NEWEST;
+        return options;
+    }
+
+    void AsyncSink::write_lines(std::vector<LogRecord> &lines, size_t count) {
+        if (count == 0 || not sink_) {
+            return;
+        }
+
+        batch_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            batch_.push_back(SinkMessage{lines[i].message(), lines[i].level(), lines[i].timestamp()});
+        }
+        sink_->write_batch(batch_);
+    }
+
+    void AsyncSink::write_evicted(LogRecord &&line) {
+        if (sink_) {
+            sink_->write_batch({SinkMessage{line.message(), line.level(), line.timestamp()}});
+        }
+    }
+
+    void AsyncSink::write_drop_summary(std::string_view summary) {
+        if (not sink_) {
+            return;
+        }
+
+        auto timestamp = std::chrono::system_clock::now();
+        std::string line(utility::format_message_view(summary, LogLevel::WARNING, timestamp));
+        sink_->write_batch({SinkMessage{line, LogLevel::WARNING, timestamp}});
+    }
+} // namespace logger
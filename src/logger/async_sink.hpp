@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "backpressure.hpp"
+#include "log_record.hpp"
+#include "sink.hpp"
+
+namespace logger {
+    // Decorator that gives a sink its own queue and worker thread. write() and write_batch() only copy the lines
+    // into a bounded queue, so a slow sink (e.g. a SocketSink waiting on a stalled peer) cannot delay the other
+    // sinks of the same logger.
+    //
+    // A full queue is handled by the QueueOptions overflow policy, as in an asynchronous Logger: lines at
+    // never_drop_level or above are never dropped, the rest are counted per level and summed up in a WARNING
+    // line written to the wrapped sink every report_interval.
+    class AsyncSink : public ILogSink {
+    public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = 8192;
+
+    public:
+        // Drops new lines below ERROR when the queue is full instead of blocking
+        explicit AsyncSink(std::unique_ptr<ILogSink> sink, size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
+        AsyncSink(std::unique_ptr<ILogSink> sink, const QueueOptions &queue_options);
+        ~AsyncSink() override;
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        // Waits until everything queued so far reached the wrapped sink, then flushes it
+        void flush() override;
+        bool is_valid() const override;
+
+        [[nodiscard]] size_t dropped_count() const;
+        [[nodiscard]] const DropCounters &drop_counters() const { return queue_.dropped(); }
+
+    private:
+        static QueueOptions drop_newest_options(size_t queue_capacity);
+
+        // The worker's write step
+        void write_lines(std::vector<LogRecord> &lines, size_t count);
+        void write_evicted(LogRecord &&line);
+        void write_drop_summary(std::string_view summary);
+
+    private:
+        std::unique_ptr<ILogSink> sink_;
+        // Worker thread only
+        std::vector<SinkMessage> batch_;
+        // The lines are queued already formatted, so a LogRecord only carries their text, level and timestamp
+        BoundedQueue<LogRecord> queue_;
+    };
+} // namespace logger
@@ -0,0 +1,189 @@
+#include "backpressure.hpp"
+
+#include "utility.hpp"
+
+namespace logger {
+    uint64_t DropCounters::total() const {
+        uint64_t sum = 0;
+        for (const auto &count: counts_) {
+            sum += count.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    DropCounters::Snapshot DropCounters::snapshot() const {
+        Snapshot result{};
+        for (size_t i = 0; i < LEVEL_COUNT; ++i) {
+            result[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    std::string DropCounters::describe(const Snapshot &current, const Snapshot &since) {
+        uint64_t total = 0;
+        std::string details = describe_levels(current, since, total);
+        if (total == 0) {
+            return {};
+        }
+
+        return "Dropped " + std::to_string(total) + " messages due to queue overflow (" + details + ")";
+    }
+
+    std::string DropCounters::describe_levels(const Snapshot &current, const Snapshot &since, uint64_t &total) {
+        total = 0;
+        std::string details;
+
+        for (size_t i = 0; i < LEVEL_COUNT; ++i) {
+            uint64_t count = current[i] - since[i];
+            if (count == 0) {
+                continue;
+            }
+
+            total += count;
+            if (not details.empty()) {
+                details += ", ";
+            }
+            details += utility::level_to_string(static_cast<LogLevel>(i)) + ": " + std::to_string(count);
+        }
+
+        return details;
+    }
+
+    BoundedQueueBase::BoundedQueueBase(const QueueOptions &options, ReportStep report_step) :
+        options_(options), report_step_(std::move(report_step)), last_drop_report_(std::chrono::steady_clock::now()) {}
+
+    void BoundedQueueBase::flush() {
+        size_t target = accepted_count_.load(std::memory_order_acquire);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        consumer_condition_.notify_one();
+        flush_condition_.wait(lock, [this, target] {
+            return written_count_.load(std::memory_order_acquire) >= target ||
+                   not running_.load(std::memory_order_acquire);
+        });
+    }
+
+    void BoundedQueueBase::wake() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        consumer_condition_.notify_one();
+    }
+
+    void BoundedQueueBase::notify() {
+        if (consumer_waiting_.load(std::memory_order_acquire)) {
+            wake();
+        }
+    }
+
+    void BoundedQueueBase::accepted(size_t depth) {
+        accepted_count_.fetch_add(1, std::memory_order_release);
+
+        size_t high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+        while (depth > high_water_mark &&
+               not high_water_mark_.compare_exchange_weak(high_water_mark, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    bool BoundedQueueBase::drop_at_once(LogLevel level) {
+        if (level >= options_.never_drop_level ||
+            (level >= options_.drop_below && options_.policy != OverflowPolicy::DROP_NEWEST)) {
+            return false;
+        }
+
+        dropped_.add(level);
+        return true;
+    }
+
+    bool BoundedQueueBase::wait_for_room(LogLevel level, const std::function<bool()> &try_push) {
+        bool bounded = level < options_.never_drop_level && options_.block_timeout.count() > 0;
+        auto deadline = std::chrono::steady_clock::now() + options_.block_timeout;
+
+        // Announced before the retry, so the consumer either sees a parked producer or the retry sees its room
+        blocked_producers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        bool pushed = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (not try_push()) {
+            if (bounded && std::chrono::steady_clock::now() >= deadline) {
+                dropped_.add(level);
+                pushed = false;
+                break;
+            }
+
+            consumer_condition_.notify_one();
+            if (bounded) {
+                space_condition_.wait_until(lock, deadline);
+            } else {
+                space_condition_.wait(lock);
+            }
+        }
+        lock.unlock();
+
+        blocked_producers_.fetch_sub(1, std::memory_order_relaxed);
+        return pushed;
+    }
+
+    void BoundedQueueBase::evicted() { written_count_.fetch_add(1, std::memory_order_release); }
+
+    void BoundedQueueBase::release_producers(size_t count) {
+        // Producers blocked on a full queue can go on while the batch is being written
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (count > 0 && blocked_producers_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            space_condition_.notify_all();
+        }
+    }
+
+    void BoundedQueueBase::written(size_t count) {
+        written_count_.fetch_add(count, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_condition_.notify_all();
+    }
+
+    bool BoundedQueueBase::wait_for_items(const std::function<bool()> &empty) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (not running_.load() && empty()) {
+            return false;
+        }
+
+        consumer_waiting_.store(true, std::memory_order_release);
+        consumer_condition_.wait_for(lock, IDLE_TIMEOUT, [this, &empty] { return not empty() || not running_.load(); });
+        consumer_waiting_.store(false, std::memory_order_release);
+        return true;
+    }
+
+    void BoundedQueueBase::report_drops(bool force) {
+        if (options_.report_interval.count() <= 0) {
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (not force && now - last_drop_report_ < options_.report_interval) {
+            return;
+        }
+        last_drop_report_ = now;
+
+        auto current = dropped_.snapshot();
+        std::string summary = DropCounters::describe(current, reported_drops_);
+        reported_drops_ = current;
+        if (not summary.empty()) {
+            report_step_(summary);
+        }
+    }
+
+    void BoundedQueueBase::finished() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_condition_.notify_all();
+    }
+
+    bool BoundedQueueBase::request_stop() {
+        if (not running_.load()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.store(false);
+        consumer_condition_.notify_one();
+        return true;
+    }
+} // namespace logger
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "log_level.hpp"
+#include "ring_buffer.hpp"
+
+namespace logger {
+    // What a bounded queue does with a message that arrives while it is full
+    enum class OverflowPolicy {
+        // Wait for room, at most QueueOptions::block_timeout when that is set; the message is dropped on timeout
+        BLOCK,
+        // Drop the incoming message
+        DROP_NEWEST,
+        // Evict the oldest queued message to make room
+        DROP_OLDEST
+    };
+
+    struct QueueOptions {
+        static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+        // Implicit, so a plain capacity still works wherever options are expected
+        QueueOptions(size_t capacity = DEFAULT_CAPACITY) : capacity(capacity) {}
+
+        size_t capacity;
+        OverflowPolicy policy = OverflowPolicy::BLOCK;
+        // Zero blocks until there is room
+        std::chrono::milliseconds block_timeout{0};
+        // Messages below this level are dropped right away when the queue is full, whatever the policy says;
+        // the policy only applies to the rest
+        LogLevel drop_below = LogLevel::DEBUG;
+        // Messages at this level or above are never dropped: a full queue makes them wait for room (the Logger
+        // ring) or takes them beyond its capacity (ThreadSafeQueue), and DROP_OLDEST never evicts them
+        LogLevel never_drop_level = LogLevel::ERROR;
+        // Priority queues only: once this many messages were taken ahead of a waiting level, that level is
+        // served next
+        size_t starvation_limit = 64;
+        // How often dropped messages are summed up in a synthetic WARNING line; zero disables the report
+        std::chrono::milliseconds report_interval{5000};
+    };
+
+    // Lock-free per-level counters of messages lost to backpressure; they only ever grow
+    class DropCounters {
+    public:
+        static constexpr size_t LEVEL_COUNT = static_cast<size_t>(LogLevel::FATAL) + 1;
+        using Snapshot = std::array<uint64_t, LEVEL_COUNT>;
+
+        void add(LogLevel level, uint64_t count = 1) {
+            counts_[static_cast<size_t>(level)].fetch_add(count, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] uint64_t count(LogLevel level) const {
+            return counts_[static_cast<size_t>(level)].load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] uint64_t total() const;
+        [[nodiscard]] Snapshot snapshot() const;
+
+        // "Dropped 12 messages due to queue overflow (DEBUG: 10, INFO: 2)" for the counts gained since `since`,
+        // or an empty string if there are none
+        [[nodiscard]] static std::string describe(const Snapshot &current, const Snapshot &since);
+        // Just the "DEBUG: 10, INFO: 2" part; `total` receives the sum of the counts gained since `since`
+        [[nodiscard]] static std::string describe_levels(const Snapshot &current, const Snapshot &since,
+                                                         uint64_t &total);
+
+    private:
+        std::array<std::atomic<uint64_t>, LEVEL_COUNT> counts_{};
+    };
+
+    // The part of BoundedQueue that does not depend on the item type: parking of blocked producers, flush()
+    // tracking and drop reporting
+    class BoundedQueueBase {
+    public:
+        // Consumer thread: writes the synthetic drop summary line
+        using ReportStep = std::function<void(std::string_view summary)>;
+
+        BoundedQueueBase(const BoundedQueueBase &) = delete;
+        BoundedQueueBase &operator=(const BoundedQueueBase &) = delete;
+
+        // Blocks until every item accepted so far has been written or evicted, or the consumer has stopped
+        void flush();
+        // Wakes the consumer thread, e.g. so the owner's write step runs a report made due from another thread
+        void wake();
+        // Wakes the consumer thread only if it is idle; cheap enough to call after every push
+        void notify();
+
+        [[nodiscard]] const QueueOptions &options() const { return options_; }
+        [[nodiscard]] const DropCounters &dropped() const { return dropped_; }
+        [[nodiscard]] size_t high_water_mark() const { return high_water_mark_.load(std::memory_order_relaxed); }
+
+    protected:
+        static constexpr size_t BATCH_SIZE = 256;
+        static constexpr std::chrono::milliseconds IDLE_TIMEOUT{10};
+        // DROP_OLDEST attempts to evict from a full queue whose head is still being written before it blocks
+        static constexpr size_t EVICTION_ATTEMPTS = 64;
+
+        BoundedQueueBase(const QueueOptions &options, ReportStep report_step);
+        ~BoundedQueueBase() = default;
+
+        // Producer side, after an item was pushed at the given queue depth
+        void accepted(size_t depth);
+        // Drops and counts an item of this level that did not fit if it goes right away, whatever the policy
+        bool drop_at_once(LogLevel level);
+        // BLOCK: retries `try_push` until it succeeds, parking until the consumer has made room in between.
+        // Items below never_drop_level give up once block_timeout has passed; returns false if the item was dropped.
+        bool wait_for_room(LogLevel level, const std::function<bool()> &try_push);
+        // DROP_OLDEST took an item off the queue; it was counted as accepted, so flush() must not wait for it
+        void evicted();
+
+        // Consumer side: lets parked producers go on once `count` items were taken off the queue
+        void release_producers(size_t count);
+        void written(size_t count);
+        // Waits up to IDLE_TIMEOUT for new items; returns false once stopped with nothing left to write
+        bool wait_for_items(const std::function<bool()> &empty);
+        // Writes the drop summary once the report interval has passed, or right away when `force`d
+        void report_drops(bool force);
+        void finished();
+
+        // Returns false if the consumer was not running
+        bool request_stop();
+
+    protected:
+        const QueueOptions options_;
+        std::atomic<bool> running_{false};
+        DropCounters dropped_;
+
+    private:
+        ReportStep report_step_;
+
+        std::atomic<bool> consumer_waiting_{false};
+        std::mutex mutex_;
+        std::condition_variable consumer_condition_;
+        std::condition_variable flush_condition_;
+        // BLOCK producers park here until the consumer has taken a batch off the queue
+        std::condition_variable space_condition_;
+        std::atomic<size_t> blocked_producers_{0};
+        std::atomic<size_t> accepted_count_{0};
+        // Written or evicted by DROP_OLDEST
+        std::atomic<size_t> written_count_{0};
+        std::atomic<size_t> high_water_mark_{0};
+
+        // Consumer thread only
+        DropCounters::Snapshot reported_drops_{};
+        std::chrono::steady_clock::time_point last_drop_report_;
+    };
+
+    // Bounded lock-free queue drained by a consumer thread of its own, with the QueueOptions overflow policy
+    // applied to items that arrive while it is full. Shared by the asynchronous Logger and AsyncSink, which only
+    // pass in how to write what comes off it. T must be default-constructible, movable and have a level().
+    template<typename T>
+    class BoundedQueue : public BoundedQueueBase {
+    public:
+        // Consumer thread: writes the first `count` items. Called with no items at least every IDLE_TIMEOUT as
+        // well, so the owner can do its periodic work there.
+        using WriteStep = std::function<void(std::vector<T> &items, size_t count)>;
+        // Producer thread: writes an item DROP_OLDEST evicted but must not drop
+        using EvictStep = std::function<void(T &&item)>;
+
+        BoundedQueue(const QueueOptions &options, WriteStep write_step, EvictStep evict_step,
+                     ReportStep report_step) :
+            BoundedQueueBase(options, std::move(report_step)), ring_(options.capacity),
+            write_step_(std::move(write_step)), evict_step_(std::move(evict_step)) {}
+
+        ~BoundedQueue() { stop(); }
+
+        // Separate from construction, so the owner can store the queue before its steps first run
+        void start() {
+            running_.store(true);
+            consumer_thread_ = std::thread(&BoundedQueue::consumer_thread_function, this);
+        }
+
+        // Writes out whatever is still queued, then joins the consumer thread
+        void stop() {
+            if (request_stop() && consumer_thread_.joinable()) {
+                consumer_thread_.join();
+            }
+        }
+
+        // Returns false if the overflow policy dropped the item. Does not wake the consumer, see notify().
+        bool push(T &&item) {
+            // try_push() leaves the item alone when the queue is full
+            if (not ring_.try_push(std::move(item)) && not handle_overflow(item)) {
+                return false;
+            }
+
+            accepted(ring_.size());
+            return true;
+        }
+
+        [[nodiscard]] size_t capacity() const { return ring_.capacity(); }
+        [[nodiscard]] size_t size() const { return ring_.size(); }
+
+    private:
+        bool handle_overflow(T &item) {
+            LogLevel level = item.level();
+            if (drop_at_once(level)) {
+                return false;
+            }
+
+            if (options_.policy != OverflowPolicy::DROP_OLDEST) {
+                return wait_for_room(level, [this, &item] { return ring_.try_push(std::move(item)); });
+            }
+
+            // The ring only allows evicting from its head, so an item that must not be dropped is written instead
+            T evicted_item;
+            size_t failed_evictions = 0;
+            while (not ring_.try_push(std::move(item))) {
+                if (not ring_.try_pop(evicted_item)) {
+                    // Full, yet nothing to evict: another thread is still busy with the slot. Let it run, and wait
+                    // like BLOCK does rather than spin if it does not finish soon.
+                    if (++failed_evictions >= EVICTION_ATTEMPTS) {
+                        return wait_for_room(level, [this, &item] { return ring_.try_push(std::move(item)); });
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (evicted_item.level() >= options_.never_drop_level) {
+                    evict_step_(std::move(evicted_item));
+                } else {
+                    dropped_.add(evicted_item.level());
+                }
+                evicted();
+            }
+            return true;
+        }
+
+        void consumer_thread_function() {
+            // Kept across batches, so whatever capacity the items hold is reused
+            std::vector<T> items(BATCH_SIZE);
+
+            while (true) {
+                size_t count = 0;
+                while (count < BATCH_SIZE && ring_.try_pop(items[count])) {
+                    ++count;
+                }
+
+                release_producers(count);
+                report_drops(false);
+                write_step_(items, count);
+
+                if (count > 0) {
+                    written(count);
+                    continue;
+                }
+
+                if (not wait_for_items([this] { return ring_.empty(); })) {
+                    break;
+                }
+            }
+
+            report_drops(true);
+            finished();
+        }
+
+    private:
+        RingBuffer<T> ring_;
+        WriteStep write_step_;
+        EvictStep evict_step_;
+        std::thread consumer_thread_;
+    };
+} // namespace logger
@@ -0,0 +1,175 @@
+#include "crash_handler.hpp"
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+#include <unistd.h>
+
+namespace logger {
+    namespace {
+        struct BufferSlot {
+            static constexpr int FREE = 0;
+            // Taken by register_buffer() but not filled in yet
+            static constexpr int CLAIMED = 1;
+            static constexpr int ACTIVE = 2;
+
+            std::atomic<int> state{FREE};
+            int fd = -1;
+            const char *data = nullptr;
+            const std::atomic<size_t> *used = nullptr;
+            const std::atomic<size_t> *written = nullptr;
+        };
+
+        static_assert(std::atomic<int>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free,
+                      "atomics read in a signal handler must be lock-free");
+
+        constexpr std::array<int, 3> HANDLED_SIGNALS = {SIGSEGV, SIGABRT, SIGTERM};
+
+        std::array<BufferSlot, CrashHandler::MAX_BUFFERS> buffer_slots;
+
+        // Guards install()/uninstall() only; the handler itself never takes it
+        std::mutex install_mutex;
+        bool installed = false;
+        std::array<struct sigaction, HANDLED_SIGNALS.size()> previous_actions;
+
+        // Several threads may crash at once; only the first one writes the buffers out
+        std::atomic<bool> flushing{false};
+
+        void write_fully(int fd, const char *data, size_t size) {
+            while (size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if (written == -1) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+        }
+
+        void write_notice(int signal_number) {
+            const char *name = signal_number == SIGSEGV   ? "SIGSEGV"
+                               : signal_number == SIGABRT ? "SIGABRT"
+                                                          : "SIGTERM";
+            const char prefix[] = "[CrashHandler] Caught ";
+            const char suffix[] = ", flushing log buffers\n";
+            write_fully(STDERR_FILENO, prefix, sizeof(prefix) - 1);
+            write_fully(STDERR_FILENO, name, std::strlen(name));
+            write_fully(STDERR_FILENO, suffix, sizeof(suffix) - 1);
+        }
+
+        void handle_signal(int signal_number) {
+            int saved_errno = errno;
+
+            write_notice(signal_number);
+            if (not flushing.exchange(true)) {
+                CrashHandler::flush_buffers();
+            }
+
+            // The signal stays blocked until the handler returns and is then delivered to the previous action,
+            // which for the default one terminates the process as if no handler had been installed
+            for (size_t i = 0; i < HANDLED_SIGNALS.size(); ++i) {
+                if (HANDLED_SIGNALS[i] == signal_number) {
+                    sigaction(signal_number, &previous_actions[i], nullptr);
+                }
+            }
+            raise(signal_number);
+
+            errno = saved_errno;
+        }
+    } // namespace
+
+    bool CrashHandler::install() {
+        std::lock_guard<std::mutex> lock(install_mutex);
+        if (installed) {
+            return true;
+        }
+
+        struct sigaction action{};
+        action.sa_handler = handle_signal;
+        sigemptyset(&action.sa_mask);
+        // Runs on an alternate stack where the thread has one, which is what makes stack overflows reportable
+        action.sa_flags = SA_ONSTACK;
+
+        for (size_t i = 0; i < HANDLED_SIGNALS.size(); ++i) {
+            if (sigaction(HANDLED_SIGNALS[i], &action, &previous_actions[i]) == -1) {
+                std::cerr << "[CrashHandler] Failed to install handler: " << strerror(errno) << std::endl;
+                while (i-- > 0) {
+                    sigaction(HANDLED_SIGNALS[i], &previous_actions[i], nullptr);
+                }
+                return false;
+            }
+        }
+
+        flushing.store(false);
+        installed = true;
+        return true;
+    }
+
+    void CrashHandler::uninstall() {
+        std::lock_guard<std::mutex> lock(install_mutex);
+        if (not installed) {
+            return;
+        }
+
+        for (size_t i = 0; i < HANDLED_SIGNALS.size(); ++i) {
+            sigaction(HANDLED_SIGNALS[i], &previous_actions[i], nullptr);
+        }
+        installed = false;
+    }
+
+    bool CrashHandler::is_installed() {
+        std::lock_guard<std::mutex> lock(install_mutex);
+        return installed;
+    }
+
+    int CrashHandler::register_buffer(int fd, const char *data, const std::atomic<size_t> *used,
+                                      const std::atomic<size_t> *written) {
+        if (fd < 0 || data == nullptr || used == nullptr) {
+            return -1;
+        }
+
+        for (size_t i = 0; i < buffer_slots.size(); ++i) {
+            auto &slot = buffer_slots[i];
+            int expected = BufferSlot::FREE;
+            if (slot.state.compare_exchange_strong(expected, BufferSlot::CLAIMED, std::memory_order_acquire)) {
+                slot.fd = fd;
+                slot.data = data;
+                slot.used = used;
+                slot.written = written;
+                slot.state.store(BufferSlot::ACTIVE, std::memory_order_release);
+                return static_cast<int>(i);
+            }
+        }
+
+        return -1;
+    }
+
+    void CrashHandler::unregister_buffer(int handle) {
+        if (handle < 0 || static_cast<size_t>(handle) >= buffer_slots.size()) {
+            return;
+        }
+
+        buffer_slots[static_cast<size_t>(handle)].state.store(BufferSlot::FREE, std::memory_order_release);
+    }
+
+    void CrashHandler::flush_buffers() {
+        for (auto &slot: buffer_slots) {
+            if (slot.state.load(std::memory_order_acquire) != BufferSlot::ACTIVE) {
+                continue;
+            }
+
+            size_t size = slot.used->load(std::memory_order_acquire);
+            size_t done = slot.written ? slot.written->load(std::memory_order_acquire) : 0;
+            if (done < size) {
+                write_fully(slot.fd, slot.data + done, size - done);
+            }
+        }
+    }
+} // namespace logger
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace logger {
+    // Process-wide handler for SIGSEGV, SIGABRT and SIGTERM that saves what buffering sinks still hold in memory.
+    //
+    // A sink registers its buffer once: the handler then writes bytes `*written` up to `*used` of `data` to `fd`
+    // with write(2) and nothing else, since locks, allocation and iostreams are off limits inside a signal handler.
+    // The sink must only publish `used` after the bytes below it are complete, and advance `written` as its own
+    // flush gets them out, so a signal landing in the middle of that flush does not write them a second time.
+    // Afterwards the previous action of the signal is restored and the signal raised again, so the process still
+    // dies (and dumps core) as before.
+    class CrashHandler {
+    public:
+        static constexpr size_t MAX_BUFFERS = 32;
+
+        // Returns false if a handler could not be installed; installing twice is a no-op
+        static bool install();
+        // Restores the actions that were in place before install()
+        static void uninstall();
+        [[nodiscard]] static bool is_installed();
+
+        // Returns a handle for unregister_buffer(), or -1 when all slots are taken. Registering works whether or
+        // not the handler is installed; the buffer has to stay alive until it is unregistered.
+        // `written` may be null for a buffer that is always flushed as a whole.
+        static int register_buffer(int fd, const char *data, const std::atomic<size_t> *used,
+                                   const std::atomic<size_t> *written = nullptr);
+        static void unregister_buffer(int handle);
+
+        // What the handler does before re-raising; async-signal-safe. The buffers themselves are left untouched.
+        static void flush_buffers();
+    };
+} // namespace logger
@@ -0,0 +1,290 @@
+#include "disk_spool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace logger {
+    namespace {
+        constexpr const char *SEGMENT_SUFFIX = ".spool";
+        // Two fixed-width numbers, so the cursor is rewritten in place without truncating the file
+        constexpr size_t CURSOR_SIZE = 42;
+    } // namespace
+
+    DiskSpool::DiskSpool(const std::string &base_path, size_t max_bytes, size_t segment_size) :
+        base_path_(base_path), max_bytes_(max_bytes), segment_size_(std::max<size_t>(segment_size, 1)) {
+        if (base_path_.empty()) {
+            return;
+        }
+
+        std::string cursor_path = base_path_ + ".cursor";
+        cursor_fd_ = open(cursor_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (cursor_fd_ == -1) {
+            std::cerr << "[DiskSpool] Failed to open " << cursor_path << ": " << strerror(errno) << std::endl;
+            return;
+        }
+
+        recover();
+        valid_ = true;
+    }
+
+    DiskSpool::~DiskSpool() {
+        close_write_segment();
+        if (cursor_fd_ != -1) {
+            close(cursor_fd_);
+        }
+    }
+
+    bool DiskSpool::is_valid() const { return valid_; }
+
+    bool DiskSpool::append(std::string_view record) {
+        if (not valid_) {
+            return false;
+        }
+
+        size_t record_size = sizeof(RecordLength) + record.size();
+
+        // Make room by deleting whole segments, oldest first; the segment being written is kept
+        while (total_bytes_ + record_size > max_bytes_ && segments_.size() > 1) {
+            dropped_bytes_ += segments_.front().size - read_offset_;
+            remove_front_segment();
+        }
+
+        if (total_bytes_ + record_size > max_bytes_) {
+            dropped_bytes_ += record_size;
+            return false;
+        }
+
+        if (write_fd_ == -1 || segments_.back().size >= segment_size_) {
+            uint64_t index = segments_.empty() ? 0 : segments_.back().index + 1;
+            if (not open_write_segment(index)) {
+                dropped_bytes_ += record_size;
+                return false;
+            }
+        }
+
+        RecordLength length = static_cast<RecordLength>(record.size());
+        iovec iovecs[2] = {{&length, sizeof(length)}, {const_cast<char *>(record.data()), record.size()}};
+
+        ssize_t written;
+        do {
+            written = writev(write_fd_, iovecs, 2);
+        } while (written == -1 && errno == EINTR);
+
+        if (written != static_cast<ssize_t>(record_size)) {
+            std::cerr << "[DiskSpool] Write failed: " << strerror(errno) << std::endl;
+            // Start a fresh segment so a torn record is never followed by valid ones
+            if (written > 0) {
+                segments_.back().size += static_cast<size_t>(written);
+                total_bytes_ += static_cast<size_t>(written);
+            }
+            close_write_segment();
+            dropped_bytes_ += record_size;
+            return false;
+        }
+
+        segments_.back().size += record_size;
+        total_bytes_ += record_size;
+        return true;
+    }
+
+    size_t DiskSpool::peek(std::vector<std::string> &records, size_t max_bytes) {
+        records.clear();
+        peeked_sizes_.clear();
+
+        while (not segments_.empty() && read_offset_ >= segments_.front().size) {
+            if (segments_.size() == 1 && write_fd_ != -1) {
+                return 0; // everything written so far has been consumed
+            }
+            remove_front_segment();
+        }
+
+        if (segments_.empty()) {
+            return 0;
+        }
+
+        // One large sequential read covering as many records as fit in max_bytes
+        const Segment &segment = segments_.front();
+        std::string path = segment_path(segment.index);
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) {
+            std::cerr << "[DiskSpool] Failed to open " << path << ": " << strerror(errno) << std::endl;
+            total_bytes_ -= segment.size - read_offset_;
+            read_offset_ = segment.size;
+            return 0;
+        }
+
+        size_t available = segment.size - read_offset_;
+        std::string buffer(std::min(available, std::max(max_bytes, sizeof(RecordLength))), '\0');
+        ssize_t bytes_read = pread(fd, buffer.data(), buffer.size(), static_cast<off_t>(read_offset_));
+
+        size_t position = 0;
+        while (bytes_read > 0 && position + sizeof(RecordLength) <= static_cast<size_t>(bytes_read)) {
+            RecordLength length;
+            std::memcpy(&length, buffer.data() + position, sizeof(length));
+            size_t record_size = sizeof(RecordLength) + length;
+
+            if (record_size > available - position) {
+                // Torn record at the end of a segment left by a crash: skip the rest of it
+                if (records.empty()) {
+                    total_bytes_ -= available;
+                    read_offset_ = segment.size;
+                }
+                break;
+            }
+
+            if (position + record_size > static_cast<size_t>(bytes_read)) {
+                if (not records.empty()) {
+                    break;
+                }
+                // The first record is larger than max_bytes, read it on its own
+                buffer.resize(record_size);
+                bytes_read = pread(fd, buffer.data(), record_size, static_cast<off_t>(read_offset_));
+                if (bytes_read != static_cast<ssize_t>(record_size)) {
+                    break;
+                }
+            }
+
+            records.emplace_back(buffer.data() + position + sizeof(RecordLength), length);
+            peeked_sizes_.push_back(record_size);
+            position += record_size;
+        }
+
+        close(fd);
+        return records.size();
+    }
+
+    void DiskSpool::consume(size_t count) {
+        count = std::min(count, peeked_sizes_.size());
+        if (count == 0) {
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            read_offset_ += peeked_sizes_[i];
+            total_bytes_ -= peeked_sizes_[i];
+        }
+        peeked_sizes_.clear();
+
+        // Fully read segments are deleted right away, including the one being written
+        if (not segments_.empty() && read_offset_ >= segments_.front().size) {
+            remove_front_segment();
+        }
+
+        save_cursor();
+    }
+
+    bool DiskSpool::empty() const { return total_bytes_ == 0; }
+
+    size_t DiskSpool::size_bytes() const { return total_bytes_; }
+
+    uint64_t DiskSpool::dropped_bytes() const { return dropped_bytes_; }
+
+    std::string DiskSpool::segment_path(uint64_t index) const {
+        return base_path_ + "." + std::to_string(index) + SEGMENT_SUFFIX;
+    }
+
+    void DiskSpool::recover() {
+        namespace fs = std::filesystem;
+
+        fs::path base(base_path_);
+        fs::path directory = base.has_parent_path() ? base.parent_path() : fs::path(".");
+        std::string prefix = base.filename().string() + ".";
+
+        std::error_code ec;
+        for (const auto &entry: fs::directory_iterator(directory, ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() <= prefix.size() + std::strlen(SEGMENT_SUFFIX) || name.rfind(prefix, 0) != 0 ||
+                name.compare(name.size() - std::strlen(SEGMENT_SUFFIX), std::string::npos, SEGMENT_SUFFIX) != 0) {
+                continue;
+            }
+
+            std::string number =
+                    name.substr(prefix.size(), name.size() - prefix.size() - std::strlen(SEGMENT_SUFFIX));
+            if (number.empty() ||
+                not std::all_of(number.begin(), number.end(), [](unsigned char c) { return std::isdigit(c); })) {
+                continue;
+            }
+
+            segments_.push_back(Segment{std::stoull(number), static_cast<size_t>(entry.file_size(ec))});
+        }
+
+        std::sort(segments_.begin(), segments_.end(),
+                  [](const Segment &a, const Segment &b) { return a.index < b.index; });
+
+        char cursor[CURSOR_SIZE + 1] = {};
+        uint64_t cursor_index = 0;
+        uint64_t cursor_offset = 0;
+        if (pread(cursor_fd_, cursor, CURSOR_SIZE, 0) == static_cast<ssize_t>(CURSOR_SIZE) &&
+            std::sscanf(cursor, "%" SCNu64 " %" SCNu64, &cursor_index, &cursor_offset) == 2) {
+            // Segments before the cursor were consumed but not deleted yet
+            while (not segments_.empty() && segments_.front().index < cursor_index) {
+                unlink(segment_path(segments_.front().index).c_str());
+                segments_.pop_front();
+            }
+            if (not segments_.empty() && segments_.front().index == cursor_index) {
+                read_offset_ = std::min<size_t>(cursor_offset, segments_.front().size);
+            }
+        }
+
+        for (const auto &segment: segments_) {
+            total_bytes_ += segment.size;
+        }
+        total_bytes_ -= read_offset_;
+    }
+
+    bool DiskSpool::open_write_segment(uint64_t index) {
+        close_write_segment();
+
+        std::string path = segment_path(index);
+        write_fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (write_fd_ == -1) {
+            std::cerr << "[DiskSpool] Failed to open " << path << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        segments_.push_back(Segment{index, 0});
+        return true;
+    }
+
+    void DiskSpool::close_write_segment() {
+        if (write_fd_ != -1) {
+            close(write_fd_);
+            write_fd_ = -1;
+        }
+    }
+
+    void DiskSpool::remove_front_segment() {
+        if (segments_.size() == 1) {
+            close_write_segment();
+        }
+
+        const Segment &segment = segments_.front();
+        total_bytes_ -= std::min(total_bytes_, segment.size - std::min(read_offset_, segment.size));
+        unlink(segment_path(segment.index).c_str());
+        segments_.pop_front();
+        read_offset_ = 0;
+        peeked_sizes_.clear();
+        save_cursor();
+    }
+
+    void DiskSpool::save_cursor() {
+        uint64_t index = segments_.empty() ? 0 : segments_.front().index;
+
+        char cursor[CURSOR_SIZE + 1];
+        std::snprintf(cursor, sizeof(cursor), "%020" PRIu64 " %020" PRIu64 "\n", index,
+                      static_cast<uint64_t>(read_offset_));
+        if (pwrite(cursor_fd_, cursor, CURSOR_SIZE, 0) != static_cast<ssize_t>(CURSOR_SIZE)) {
+            std::cerr << "[DiskSpool] Failed to save cursor: " << strerror(errno) << std::endl;
+        }
+    }
+} // namespace logger
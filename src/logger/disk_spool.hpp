@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace logger {
+    // Append-only on-disk FIFO of records, used by SocketSink to hold messages during long collector outages.
+    // Records are stored length-prefixed in segment files "<base_path>.<index>.spool"; the read position is kept
+    // in "<base_path>.cursor", so a spool left behind by a previous run is picked up again on construction.
+    // Not thread-safe, the owner serializes access.
+    class DiskSpool {
+    public:
+        static constexpr size_t DEFAULT_MAX_BYTES = 256 * 1024 * 1024;
+        static constexpr size_t DEFAULT_SEGMENT_SIZE = 16 * 1024 * 1024;
+
+    public:
+        DiskSpool(const std::string &base_path, size_t max_bytes = DEFAULT_MAX_BYTES,
+                  size_t segment_size = DEFAULT_SEGMENT_SIZE);
+        ~DiskSpool();
+
+        DiskSpool(const DiskSpool &) = delete;
+        DiskSpool &operator=(const DiskSpool &) = delete;
+
+        bool is_valid() const;
+
+        // Once max_bytes is reached the oldest segments are deleted; returns false if the record was dropped
+        bool append(std::string_view record);
+
+        // Reads the oldest records, up to about max_bytes but at least one, without removing them.
+        // Consecutive calls return the same records until they are consumed.
+        size_t peek(std::vector<std::string> &records, size_t max_bytes);
+        // Removes the first `count` records returned by the last peek()
+        void consume(size_t count);
+
+        bool empty() const;
+        // Bytes of unconsumed records including their length prefixes
+        size_t size_bytes() const;
+        // Bytes deleted because the size cap was reached
+        uint64_t dropped_bytes() const;
+
+    private:
+        using RecordLength = uint32_t;
+
+        struct Segment {
+            uint64_t index;
+            size_t size;
+        };
+
+        std::string segment_path(uint64_t index) const;
+        void recover();
+        bool open_write_segment(uint64_t index);
+        void close_write_segment();
+        void remove_front_segment();
+        void save_cursor();
+
+    private:
+        std::string base_path_;
+        size_t max_bytes_;
+        size_t segment_size_;
+        bool valid_ = false;
+
+        std::deque<Segment> segments_;
+        int write_fd_ = -1;
+        int cursor_fd_ = -1;
+        size_t read_offset_ = 0;
+        size_t total_bytes_ = 0;
+        uint64_t dropped_bytes_ = 0;
+
+        // On-disk sizes of the records handed out by the last peek()
+        std::vector<size_t> peeked_sizes_;
+    };
+} // namespace logger
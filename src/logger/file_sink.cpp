@@ -1,9 +1,34 @@
 #include "file_sink.hpp"
 
+#include <algorithm>
+
 namespace logger {
-    FileSink::FileSink(const std::string &filename) { file_stream_.open(filename, std::ios::app); }
+    FileSink::FileSink(const std::string &filename, const FlushPolicy &flush_policy) : flush_policy_(flush_policy) {
+        // A stream buffer at least as large as the flush threshold keeps ofstream from writing on its own earlier
+        if (flush_policy_.max_buffered_bytes > 0) {
+            stream_buffer_.resize(flush_policy_.max_buffered_bytes);
+            file_stream_.rdbuf()->pubsetbuf(stream_buffer_.data(), stream_buffer_.size());
+        }
+
+        file_stream_.open(filename, std::ios::app);
+        healthy_.store(file_stream_.is_open() && file_stream_.good(), std::memory_order_release);
+
+        if (file_stream_.is_open() && flush_policy_.flush_interval.count() > 0) {
+            flush_thread_ = std::thread(&FileSink::flush_thread_function, this);
+        }
+    }
 
     FileSink::~FileSink() {
+        {
+            std::lock_guard<std::mutex> lock(fs_mutex_);
+            stopping_ = true;
+            flush_condition_.notify_all();
+        }
+
+        if (flush_thread_.joinable()) {
+            flush_thread_.join();
+        }
+
         if (file_stream_.is_open()) {
             file_stream_.close();
         }
@@ -15,11 +40,54 @@ namespace logger {
         }
 
         std::lock_guard<std::mutex> lock(fs_mutex_);
-        file_stream_ << message << std::endl;
+        file_stream_ << message << '\n';
+        pending_bytes_ += message.size() + 1;
+        flush_if_needed(false);
+        healthy_.store(file_stream_.good(), std::memory_order_release);
+    }
+
+    void FileSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid()) {
+            return;
+        }
+
+        bool urgent = false;
+
+        std::lock_guard<std::mutex> lock(fs_mutex_);
+        for (const auto &message: messages) {
+            file_stream_ << message.text << '\n';
+            pending_bytes_ += message.text.size() + 1;
+            urgent = urgent || message.level >= flush_policy_.flush_level;
+        }
+        flush_if_needed(urgent);
+        healthy_.store(file_stream_.good(), std::memory_order_release);
     }
 
-    bool FileSink::is_valid() const {
+    void FileSink::flush() {
         std::lock_guard<std::mutex> lock(fs_mutex_);
-        return file_stream_.is_open() && file_stream_.good();
+        flush_if_needed(true);
+        healthy_.store(file_stream_.good(), std::memory_order_release);
+    }
+
+    bool FileSink::is_valid() const { return healthy_.load(std::memory_order_acquire); }
+
+    void FileSink::flush_thread_function() {
+        std::unique_lock<std::mutex> lock(fs_mutex_);
+
+        while (not stopping_) {
+            flush_condition_.wait_for(lock, flush_policy_.flush_interval);
+            flush_if_needed(true);
+        }
+    }
+
+    void FileSink::flush_if_needed(bool force) {
+        if (pending_bytes_ == 0) {
+            return;
+        }
+
+        if (force || pending_bytes_ >= flush_policy_.max_buffered_bytes) {
+            file_stream_.flush();
+            pending_bytes_ = 0;
+        }
     }
 } // namespace logger
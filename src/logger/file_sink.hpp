@@ -1,22 +1,45 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "flush_policy.hpp"
 #include "sink.hpp"
 
 namespace logger {
     class FileSink : public ILogSink {
     private:
         std::ofstream file_stream_;
-        mutable std::mutex fs_mutex_;
+        std::mutex fs_mutex_;
+        // Stream state cached after every write, so is_valid() does not take fs_mutex_
+        std::atomic<bool> healthy_{false};
+
+        FlushPolicy flush_policy_;
+        std::vector<char> stream_buffer_;
+        size_t pending_bytes_ = 0;
+
+        // Periodic flushing, only started when flush_policy_.flush_interval is set
+        std::thread flush_thread_;
+        std::condition_variable flush_condition_;
+        bool stopping_ = false;
 
     public:
-        explicit FileSink(const std::string &filename);
+        explicit FileSink(const std::string &filename, const FlushPolicy &flush_policy = FlushPolicy());
         ~FileSink() override;
 
         void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        void flush() override;
         bool is_valid() const override;
+
+    private:
+        void flush_thread_function();
+        // Expects fs_mutex_ to be held
+        void flush_if_needed(bool force);
     };
 } // namespace logger
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include "log_level.hpp"
+
+namespace logger {
+    // When a buffering sink pushes its buffered data to the OS.
+    // The default flushes after every write.
+    struct FlushPolicy {
+        // Flush once at least this many bytes are buffered (0 = after every write)
+        size_t max_buffered_bytes = 0;
+        // Flush pending data at least this often, even without new writes (0 = disabled)
+        std::chrono::milliseconds flush_interval{0};
+        // Messages at or above this level are flushed immediately
+        LogLevel flush_level = LogLevel::ERROR;
+    };
+} // namespace logger
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <charconv>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "log_level.hpp"
+#include "utility.hpp"
+
+namespace logger {
+    namespace utility {
+        namespace detail {
+            // `Out` is a std::string or anything else with append(std::string_view) and push_back(char)
+            template<typename Out, typename T>
+            void append_argument(Out &out, const T &value) {
+                if constexpr (std::is_same_v<T, bool>) {
+                    out.append(std::string_view(value ? "true" : "false"));
+                } else if constexpr (std::is_same_v<T, char>) {
+                    out.push_back(value);
+                } else if constexpr (std::is_same_v<T, logger::LogLevel>) {
+                    out.append(level_to_string_view(value));
+                } else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+                    char buffer[64];
+                    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                    if (ec == std::errc()) {
+                        out.append(std::string_view(buffer, static_cast<size_t>(end - buffer)));
+                    }
+                } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+                    out.append(std::string_view(value));
+                } else {
+                    std::ostringstream oss;
+                    oss << value;
+                    out.append(std::string_view(oss.str()));
+                }
+            }
+
+            // Appends text up to the next "{}" placeholder, unescaping "{{" and "}}".
+            // Returns true if a placeholder was consumed.
+            template<typename Out>
+            bool append_until_placeholder(Out &out, std::string_view &format) {
+                // Literal text is appended in runs rather than character by character
+                size_t start = 0;
+                size_t i = 0;
+                while (i < format.size()) {
+                    char c = format[i];
+                    bool has_next = i + 1 < format.size();
+
+                    if (c == '{' && has_next && format[i + 1] == '}') {
+                        out.append(format.substr(start, i - start));
+                        format.remove_prefix(i + 2);
+                        return true;
+                    }
+                    if ((c == '{' || c == '}') && has_next && format[i + 1] == c) {
+                        out.append(format.substr(start, i + 1 - start));
+                        i += 2;
+                        start = i;
+                        continue;
+                    }
+                    ++i;
+                }
+
+                out.append(format.substr(start));
+                format.remove_prefix(format.size());
+                return false;
+            }
+
+            template<typename Out>
+            void format_to(Out &out, std::string_view format) {
+                while (append_until_placeholder(out, format)) {
+                    out.append(std::string_view("{}")); // more placeholders than arguments
+                }
+            }
+
+            template<typename Out, typename Arg, typename... Args>
+            void format_to(Out &out, std::string_view format, const Arg &arg, const Args &...args) {
+                if (not append_until_placeholder(out, format)) {
+                    return; // more arguments than placeholders
+                }
+
+                append_argument(out, arg);
+                format_to(out, format, args...);
+            }
+        } // namespace detail
+
+        // Minimal "{}" formatter: each "{}" is replaced by the next argument, "{{" and "}}" produce literal braces
+        template<typename... Args>
+        [[nodiscard]] std::string format(std::string_view format_string, const Args &...args) {
+            std::string result;
+            result.reserve(format_string.size() + sizeof...(Args) * 16);
+            detail::format_to(result, format_string, args...);
+            return result;
+        }
+
+        // Like format(), but appends to `out`, e.g. straight into a LogRecord (see detail::append_argument)
+        template<typename Out, typename... Args>
+        void format_to(Out &out, std::string_view format_string, const Args &...args) {
+            detail::format_to(out, format_string, args...);
+        }
+    } // namespace utility
+} // namespace logger
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "logger.hpp"
+
+// Calls below LOGGER_MIN_LEVEL are removed at compile time together with their arguments.
+// Enabled calls check the logger's runtime level with a single relaxed load before the message is evaluated;
+// calls it rejects are only counted (Logger::stats()). Each call keeps a static CallSite for per-call-site rate limits.
+// Accepts a message, a callable producing one, or a "{}" format string followed by its arguments.
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+#define LOGGER_LOG(logger_ptr, level, ...)                                                                             \
+    do {                                                                                                               \
+        if constexpr (static_cast<int>(level) >= LOGGER_MIN_LEVEL) {                                                   \
+            if ((logger_ptr)->is_enabled(level)) {                                                                     \
+                static constexpr ::logger::CallSite logger_call_site(__FILE__, __LINE__);                              \
+                (logger_ptr)->log_at(logger_call_site, (level), __VA_ARGS__);                                          \
+            } else {                                                                                                   \
+                (logger_ptr)->record_filtered(level);                                                                  \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+#define LOG_DEBUG(logger_ptr, ...) LOGGER_LOG(logger_ptr, ::logger::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(logger_ptr, ...) LOGGER_LOG(logger_ptr, ::logger::LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARNING(logger_ptr, ...) LOGGER_LOG(logger_ptr, ::logger::LogLevel::WARNING, __VA_ARGS__)
+#define LOG_ERROR(logger_ptr, ...) LOGGER_LOG(logger_ptr, ::logger::LogLevel::ERROR, __VA_ARGS__)
+#define LOG_FATAL(logger_ptr, ...) LOGGER_LOG(logger_ptr, ::logger::LogLevel::FATAL, __VA_ARGS__)
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "log_level.hpp"
+
+namespace logger {
+    // Message as captured on the producer thread: the clock tick, the level and the message bytes. The "{}"
+    // arguments of the lazy log overloads are formatted into it on the producer thread as well; what is deferred
+    // to the backend thread is the timestamp/level prefix and the write to the sinks.
+    // Short messages are kept inline so that capturing them does not touch the allocator.
+    class LogRecord {
+    public:
+        static constexpr size_t INLINE_CAPACITY = 128;
+
+    public:
+        LogRecord() = default;
+        // An empty message to be built with append(), e.g. by utility::format_to()
+        explicit LogRecord(LogLevel level,
+                           std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) :
+            level_(level), timestamp_(timestamp) {}
+        LogRecord(std::string_view message, LogLevel level,
+                  std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now()) :
+            level_(level), timestamp_(timestamp) {
+            set_message(message);
+        }
+
+        void set_message(std::string_view message) {
+            size_ = message.size();
+            if (size_ <= INLINE_CAPACITY) {
+                std::memcpy(inline_data_, message.data(), size_);
+                overflow_.clear();
+            } else {
+                overflow_.assign(message.data(), message.size());
+            }
+        }
+
+        // Text stays inline until the message outgrows INLINE_CAPACITY, then all of it moves to the heap
+        void append(std::string_view text) {
+            size_t size = size_ + text.size();
+            if (size <= INLINE_CAPACITY) {
+                std::memcpy(inline_data_ + size_, text.data(), text.size());
+            } else {
+                if (size_ <= INLINE_CAPACITY) {
+                    overflow_.reserve(std::max(size, 2 * INLINE_CAPACITY));
+                    overflow_.assign(inline_data_, size_);
+                }
+                overflow_.append(text.data(), text.size());
+            }
+            size_ = size;
+        }
+
+        void push_back(char c) { append(std::string_view(&c, 1)); }
+
+        [[nodiscard]] std::string_view message() const {
+            return size_ <= INLINE_CAPACITY ? std::string_view(inline_data_, size_) : std::string_view(overflow_);
+        }
+
+        [[nodiscard]] LogLevel level() const { return level_; }
+        [[nodiscard]] std::chrono::system_clock::time_point timestamp() const { return timestamp_; }
+
+    private:
+        LogLevel level_ = LogLevel::INFO;
+        std::chrono::system_clock::time_point timestamp_;
+        size_t size_ = 0;
+        char inline_data_[INLINE_CAPACITY];
+        std::string overflow_;
+    };
+} // namespace logger
@@ -1,7 +1,11 @@
 #include "logger.hpp"
 
+#include <algorithm>
+
 #include "file_sink.hpp"
+#include "shm_sink.hpp"
 #include "socket_sink.hpp"
+#include "udp_sink.hpp"
 
 namespace logger {
     std::shared_ptr<Logger> Logger::create_logger(const std::string &filename, LogLevel default_level) {
@@ -19,52 +23,149 @@ namespace logger {
     std::shared_ptr<Logger> Logger::create_logger(const std::string &host, int port, LogLevel default_level) {
         auto logger = std::shared_ptr<Logger>(new Logger(default_level));
 
-        auto socket_sink = std::make_unique<SocketSink>(host, port);
-        if (not socket_sink->is_valid()) {
+        // "shm:<name>" goes through a shared memory ring instead of a socket, "udp:<address>" through a UdpSink
+        std::unique_ptr<ILogSink> sink;
+        if (ShmRing::is_shm_address(host)) {
+            sink = std::make_unique<ShmSink>(host);
+        } else if (SocketEndpoint endpoint = SocketEndpoint::parse(host, port); endpoint.is_udp()) {
+            sink = std::make_unique<UdpSink>(endpoint);
+        } else {
+            sink = std::make_unique<SocketSink>(host, port);
+        }
+
+        if (not sink->is_valid()) {
+            return nullptr;
+        }
+
+        logger->add_sink(std::move(sink));
+        return logger;
+    }
+
+    std::shared_ptr<Logger> Logger::create_logger(const std::string &filename, const RotationPolicy &rotation_policy,
+                                                  LogLevel default_level) {
+        auto logger = std::shared_ptr<Logger>(new Logger(default_level));
+
+        auto rotating_sink = std::make_unique<RotatingFileSink>(filename, rotation_policy);
+        if (not rotating_sink->is_valid()) {
+            return nullptr;
+        }
+
+        logger->add_sink(std::move(rotating_sink));
+        return logger;
+    }
+
+    std::shared_ptr<Logger> Logger::create_async_logger(const std::string &filename, LogLevel default_level,
+                                                        const QueueOptions &queue_options) {
+        auto logger = create_logger(filename, default_level);
+        if (not logger) {
+            return nullptr;
+        }
+
+        logger->start_backend(queue_options);
+        return logger;
+    }
+
+    std::shared_ptr<Logger> Logger::create_async_logger(const std::string &host, int port, LogLevel default_level,
+                                                        const QueueOptions &queue_options) {
+        auto logger = create_logger(host, port, default_level);
+        if (not logger) {
+            return nullptr;
+        }
+
+        logger->start_backend(queue_options);
+        return logger;
+    }
+
+    std::shared_ptr<Logger> Logger::create_async_logger(const std::string &filename,
+                                                        const RotationPolicy &rotation_policy, LogLevel default_level,
+                                                        const QueueOptions &queue_options) {
+        auto logger = create_logger(filename, rotation_policy, default_level);
+        if (not logger) {
             return nullptr;
         }
 
-        logger->add_sink(std::move(socket_sink));
+        logger->start_backend(queue_options);
         return logger;
     }
 
-    Logger::Logger(LogLevel default_level) : default_level_(default_level) {}
+    Logger::Logger(LogLevel default_level) : sinks_(std::make_shared<SinkList>()), default_level_(default_level) {}
+
+    Logger::~Logger() { stop_backend(); }
 
-    void Logger::add_sink(std::unique_ptr<ILogSink> sink) {
+    void Logger::add_sink(std::unique_ptr<ILogSink> sink, LogLevel min_level) {
         if (sink) {
             std::lock_guard<std::mutex> lock(sinks_mutex_);
-            sinks_.push_back(std::move(sink));
+            auto sinks = std::make_shared<SinkList>(*load_sinks());
+            sinks->push_back(SinkEntry{std::move(sink), min_level, std::make_shared<SinkCounters>()});
+            std::atomic_store_explicit(&sinks_, std::shared_ptr<const SinkList>(std::move(sinks)),
+                                       std::memory_order_release);
         }
     }
 
     void Logger::clear_sinks() {
         std::lock_guard<std::mutex> lock(sinks_mutex_);
-        sinks_.clear();
+        std::atomic_store_explicit(&sinks_, std::shared_ptr<const SinkList>(std::make_shared<SinkList>()),
+                                   std::memory_order_release);
     }
 
-    size_t Logger::sink_count() const {
-        std::lock_guard<std::mutex> lock(sinks_mutex_);
-        return sinks_.size();
-    }
+    size_t Logger::sink_count() const { return load_sinks()->size(); }
 
     void Logger::log(std::string_view message, LogLevel level) {
-        if (level < default_level_) {
+        if (not is_enabled(level)) {
+            record_filtered(level);
             return;
         }
 
-        if (not is_valid()) {
+        if (admit(level, nullptr)) {
+            write_message(message, level);
+        }
+    }
+
+    void Logger::write_message(std::string_view message, LogLevel level) {
+        accepted_.add(level);
+
+        if (queue_) {
+            queue_->push(LogRecord(message, level));
+            queue_->notify();
+        } else {
+            auto sinks = load_sinks();
+            if (not has_valid_sink(*sinks)) {
+                return;
+            }
+
+            thread_local std::vector<SinkMessage> batch(1);
+            auto timestamp = std::chrono::system_clock::now();
+            batch[0] = SinkMessage{utility::format_message_view(message, level, timestamp), level, timestamp};
+            write_to_sinks(*sinks, batch);
+            latency_.record(std::chrono::system_clock::now() - timestamp);
+            report_stats();
+            report_suppressed(false);
+        }
+
+        // A fatal message is typically the last one before the process goes down, so it does not return until
+        // everything queued before it has reached the sinks and their buffers are flushed
+        if (level == LogLevel::FATAL) {
+            flush();
+        }
+    }
+
+    void Logger::write_record(LogRecord &&record) {
+        if (not queue_) {
+            write_message(record.message(), record.level());
             return;
         }
 
-        std::string formatted_message = utility::format_message(message, level);
+        LogLevel level = record.level();
+        accepted_.add(level);
+        queue_->push(std::move(record));
+        queue_->notify();
 
-        std::lock_guard<std::mutex> lock(sinks_mutex_);
-        for (const auto &sink: sinks_) {
-            sink->write(formatted_message);
+        if (level == LogLevel::FATAL) {
+            flush();
         }
     }
 
-    void Logger::log(std::string_view message) { log(message, default_level_); }
+    void Logger::log(std::string_view message) { log(message, get_default_level()); }
 
     void Logger::debug(std::string_view message) { log(message, LogLevel::DEBUG); }
     void Logger::info(std::string_view message) { log(message, LogLevel::INFO); }
@@ -72,17 +173,275 @@ namespace logger {
     void Logger::error(std::string_view message) { log(message, LogLevel::ERROR); }
     void Logger::fatal(std::string_view message) { log(message, LogLevel::FATAL); }
 
-    void Logger::set_default_level(LogLevel level) { default_level_ = level; }
-    LogLevel Logger::get_default_level() const { return default_level_; }
+    void Logger::flush() {
+        if (queue_) {
+            queue_->flush();
+        }
 
-    bool Logger::is_valid() const {
-        std::lock_guard<std::mutex> lock(sinks_mutex_);
-        if (sinks_.empty()) {
-            return false;
+        for (const auto &entry: *load_sinks()) {
+            entry.sink->flush();
         }
+    }
+
+    void Logger::set_default_level(LogLevel level) { default_level_.store(level, std::memory_order_relaxed); }
+    LogLevel Logger::get_default_level() const { return default_level_.load(std::memory_order_relaxed); }
+
+    bool Logger::is_valid() const { return has_valid_sink(*load_sinks()); }
+
+    bool Logger::is_async() const { return queue_ != nullptr; }
+
+    uint64_t Logger::dropped_count() const { return queue_ ? queue_->dropped().total() : 0; }
+
+    uint64_t Logger::dropped_count(LogLevel level) const { return queue_ ? queue_->dropped().count(level) : 0; }
+
+    void Logger::set_rate_limits(const RateLimitOptions &options) {
+        std::shared_ptr<RateLimiter> limiter(new RateLimiter(options),
+                                             [this](RateLimiter *retired) { retire_rate_limiter(retired); });
+
+        {
+            std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+            std::atomic_store_explicit(&rate_limiter_, std::move(limiter), std::memory_order_release);
+            rate_limited_.store(true, std::memory_order_relaxed);
+        }
+        flush_suppressed();
+    }
+
+    void Logger::clear_rate_limits() {
+        {
+            std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+            rate_limited_.store(false, std::memory_order_relaxed);
+            std::atomic_store_explicit(&rate_limiter_, std::shared_ptr<RateLimiter>(), std::memory_order_release);
+        }
+        flush_suppressed();
+    }
+
+    void Logger::retire_rate_limiter(RateLimiter *limiter) {
+        std::unique_ptr<RateLimiter> owned(limiter);
+
+        // Nothing else uses the limiter any more, so describe_suppressed() cannot overlap with a report
+        std::string summary;
+        if (limiter->options().report_interval.count() > 0) {
+            summary = limiter->describe_suppressed();
+        }
+
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        for (size_t i = 0; i < DropCounters::LEVEL_COUNT; ++i) {
+            auto level = static_cast<LogLevel>(i);
+            retired_suppressed_.add(level, limiter->suppressed().count(level));
+        }
+        if (not summary.empty()) {
+            retired_summaries_.push_back(std::move(summary));
+        }
+    }
+
+    void Logger::flush_suppressed() {
+        // What the replaced limiter suppressed is reported at the next check rather than lost with it
+        next_suppressed_report_.store(0, std::memory_order_relaxed);
+        if (queue_) {
+            queue_->wake();
+        } else {
+            report_suppressed(false);
+        }
+    }
+
+    LoggerStats Logger::stats() const {
+        LoggerStats result;
+        result.accepted = accepted_.snapshot();
+        result.filtered = filtered_.snapshot();
+
+        result.suppressed = retired_suppressed_.snapshot();
+        if (auto limiter = std::atomic_load_explicit(&rate_limiter_, std::memory_order_acquire)) {
+            auto suppressed = limiter->suppressed().snapshot();
+            for (size_t i = 0; i < suppressed.size(); ++i) {
+                result.suppressed[i] += suppressed[i];
+            }
+        }
+
+        for (const auto &entry: *load_sinks()) {
+            result.sinks.push_back(LoggerStats::Sink{entry.counters->messages.load(std::memory_order_relaxed),
+                                                     entry.counters->bytes.load(std::memory_order_relaxed),
+                                                     entry.counters->errors.load(std::memory_order_relaxed)});
+        }
+
+        if (queue_) {
+            result.dropped = queue_->dropped().snapshot();
+            result.queue_capacity = queue_->capacity();
+            result.queue_high_water_mark = queue_->high_water_mark();
+        }
+
+        result.latency = latency_.snapshot();
+        return result;
+    }
+
+    void Logger::set_stats_interval(std::chrono::milliseconds interval) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        next_stats_report_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(now + interval).count(),
+                                 std::memory_order_relaxed);
+        stats_interval_ms_.store(interval.count(), std::memory_order_relaxed);
+    }
+
+    void Logger::start_backend(const QueueOptions &queue_options) {
+        queue_ = std::make_unique<BoundedQueue<LogRecord>>(
+                queue_options,
+                [this](std::vector<LogRecord> &records, size_t count) { write_backend_batch(records, count); },
+                [this](LogRecord &&record) { write_evicted(std::move(record)); },
+                [this](std::string_view summary) { write_line(summary, LogLevel::WARNING); });
+        queue_->start();
+    }
+
+    void Logger::stop_backend() {
+        if (queue_) {
+            queue_->stop();
+            report_suppressed(true);
+        }
+    }
+
+    void Logger::write_evicted(LogRecord &&record) {
+        std::string line(utility::format_message_view(record.message(), record.level(), record.timestamp()));
+        write_to_sinks(*load_sinks(), {SinkMessage{line, record.level(), record.timestamp()}});
+    }
+
+    void Logger::report_stats() {
+        int64_t interval_ms = stats_interval_ms_.load(std::memory_order_relaxed);
+        if (interval_ms <= 0) {
+            return;
+        }
+
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        int64_t next = next_stats_report_.load(std::memory_order_relaxed);
+        if (now < next || not next_stats_report_.compare_exchange_strong(next, now + interval_ms * 1'000'000,
+                                                                          std::memory_order_relaxed)) {
+            return;
+        }
+
+        write_line(stats().describe(), LogLevel::INFO);
+    }
+
+    void Logger::report_suppressed(bool force) {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        int64_t next = next_suppressed_report_.load(std::memory_order_relaxed);
+        if (not force && now < next) {
+            return;
+        }
+
+        // Without a limiter reporting on an interval nothing new is suppressed, so nothing is due until the next
+        // set_rate_limits()
+        auto limiter = std::atomic_load_explicit(&rate_limiter_, std::memory_order_acquire);
+        int64_t following = std::numeric_limits<int64_t>::max();
+        if (limiter && limiter->options().report_interval.count() > 0) {
+            following = now + std::chrono::duration_cast<std::chrono::nanoseconds>(limiter->options().report_interval)
+                                      .count();
+        }
+        if (not next_suppressed_report_.compare_exchange_strong(next, following, std::memory_order_relaxed) &&
+            not force) {
+            return;
+        }
+
+        // What retired limiters left behind comes first
+        std::vector<std::string> summaries;
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex_);
+            summaries.swap(retired_summaries_);
+        }
+
+        if (limiter && limiter->options().report_interval.count() > 0) {
+            // Forced reports may run alongside a regular one, and describe_suppressed() calls must not overlap
+            std::lock_guard<std::mutex> lock(rate_limiter_mutex_);
+            std::string summary = limiter->describe_suppressed();
+            if (not summary.empty()) {
+                summaries.push_back(std::move(summary));
+            }
+        }
+
+        for (const auto &summary: summaries) {
+            write_line(summary, LogLevel::WARNING);
+        }
+    }
+
+    void Logger::write_line(std::string_view text, LogLevel level) {
+        auto timestamp = std::chrono::system_clock::now();
+        std::string line(utility::format_message_view(text, level, timestamp));
+        write_to_sinks(*load_sinks(), {SinkMessage{line, level, timestamp}});
+    }
+
+    void Logger::write_backend_batch(std::vector<LogRecord> &records, size_t count) {
+        report_stats();
+        report_suppressed(false);
+        if (count == 0) {
+            return;
+        }
+
+        formatted_.resize(std::max(formatted_.size(), count));
+        batch_.clear();
+        for (size_t i = 0; i < count; ++i) {
+            const auto &record = records[i];
+            formatted_[i].assign(utility::format_message_view(record.message(), record.level(), record.timestamp()));
+            batch_.push_back(SinkMessage{formatted_[i], record.level(), record.timestamp()});
+        }
+
+        write_to_sinks(*load_sinks(), batch_);
+
+        auto written_at = std::chrono::system_clock::now();
+        for (const auto &message: batch_) {
+            latency_.record(written_at - message.timestamp);
+        }
+    }
+
+    void Logger::write_to_sinks(const SinkList &sinks, const std::vector<SinkMessage> &messages) {
+        LogLevel lowest_level = LogLevel::FATAL;
+        for (const auto &message: messages) {
+            lowest_level = std::min(lowest_level, message.level);
+        }
+
+        thread_local std::vector<SinkMessage> filtered;
+
+        for (const auto &entry: sinks) {
+            if (entry.min_level <= lowest_level) {
+                entry.sink->write_batch(messages);
+                count_sink_write(entry, messages);
+                continue;
+            }
+
+            filtered.clear();
+            for (const auto &message: messages) {
+                if (message.level >= entry.min_level) {
+                    filtered.push_back(message);
+                }
+            }
+
+            if (not filtered.empty()) {
+                entry.sink->write_batch(filtered);
+                count_sink_write(entry, filtered);
+            }
+        }
+    }
+
+    void Logger::count_sink_write(const SinkEntry &entry, const std::vector<SinkMessage> &messages) {
+        // Sinks report failures only through is_valid(), which is cheap by contract
+        if (not entry.sink->is_valid()) {
+            entry.counters->errors.fetch_add(messages.size(), std::memory_order_relaxed);
+            return;
+        }
+
+        size_t bytes = 0;
+        for (const auto &message: messages) {
+            bytes += message.text.size();
+        }
+        entry.counters->messages.fetch_add(messages.size(), std::memory_order_relaxed);
+        entry.counters->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<const Logger::SinkList> Logger::load_sinks() const {
+        return std::atomic_load_explicit(&sinks_, std::memory_order_acquire);
+    }
 
-        for (const auto &sink: sinks_) {
-            if (sink->is_valid()) {
+    bool Logger::has_valid_sink(const SinkList &sinks) {
+        for (const auto &entry: sinks) {
+            if (entry.sink->is_valid()) {
                 return true;
             }
         }
@@ -1,26 +1,67 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "backpressure.hpp"
+#include "format.hpp"
+#include "log_record.hpp"
+#include "logger_stats.hpp"
+#include "rate_limiter.hpp"
+#include "rotating_file_sink.hpp"
 #include "sink.hpp"
 #include "utility.hpp"
 
 namespace logger {
     class Logger {
+    public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = QueueOptions::DEFAULT_CAPACITY;
+
+        struct SinkEntry {
+            std::shared_ptr<ILogSink> sink;
+            LogLevel min_level;
+            std::shared_ptr<SinkCounters> counters;
+        };
+        using SinkList = std::vector<SinkEntry>;
+
     public:
         [[nodiscard]] static std::shared_ptr<Logger> create_logger(const std::string &filename,
                                                                    LogLevel default_level = LogLevel::INFO);
+        // `host` may also be a Unix socket or "udp:" address (see SocketEndpoint) or "shm:<name>" for a ShmSink
         [[nodiscard]] static std::shared_ptr<Logger> create_logger(const std::string &host, int port,
                                                                    LogLevel default_level = LogLevel::INFO);
+        // Writes to a RotatingFileSink instead of a single ever-growing file
+        [[nodiscard]] static std::shared_ptr<Logger> create_logger(const std::string &filename,
+                                                                   const RotationPolicy &rotation_policy,
+                                                                   LogLevel default_level = LogLevel::INFO);
+
+        // Asynchronous loggers only push messages into a bounded lock-free queue;
+        // a dedicated backend thread drains it into the sinks. The queue options (or just a capacity) decide what
+        // happens to a message that arrives while the queue is full.
+        [[nodiscard]] static std::shared_ptr<Logger>
+        create_async_logger(const std::string &filename, LogLevel default_level = LogLevel::INFO,
+                            const QueueOptions &queue_options = QueueOptions());
+        [[nodiscard]] static std::shared_ptr<Logger>
+        create_async_logger(const std::string &host, int port, LogLevel default_level = LogLevel::INFO,
+                            const QueueOptions &queue_options = QueueOptions());
+        [[nodiscard]] static std::shared_ptr<Logger>
+        create_async_logger(const std::string &filename, const RotationPolicy &rotation_policy,
+                            LogLevel default_level = LogLevel::INFO,
+                            const QueueOptions &queue_options = QueueOptions());
 
-        ~Logger() = default;
+        ~Logger();
 
-        void add_sink(std::unique_ptr<ILogSink> sink);
+        // The sink only receives messages at min_level or above; messages below the logger's own level never
+        // reach any sink. Wrap a sink in an AsyncSink to give it an independent queue and worker thread.
+        void add_sink(std::unique_ptr<ILogSink> sink, LogLevel min_level = LogLevel::DEBUG);
         void clear_sinks();
         size_t sink_count() const;
 
@@ -31,19 +72,218 @@ namespace logger {
         void info(std::string_view message);
         void warning(std::string_view message);
         void error(std::string_view message);
+        // Like every FATAL message, also drains the queue and flushes all sinks before returning (see flush())
         void fatal(std::string_view message);
 
+        // Lazy variants: the callable or the "{}" format string is only evaluated once the level check passes,
+        // e.g. logger->debug([&] { return dump(state); }) or logger->info("x={} y={}", x, y).
+        // With no arguments the second form logs the string as is. Formatting itself still runs on the calling
+        // thread, asynchronous loggers included: the text is built straight into the LogRecord, so a message of
+        // up to LogRecord::INLINE_CAPACITY bytes costs no allocation, a longer one a single heap buffer, and an
+        // argument without a built-in conversion a std::ostringstream.
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void log(LogLevel level, Callable &&make_message) {
+            if (not is_enabled(level)) {
+                record_filtered(level);
+                return;
+            }
+
+            if (admit(level, nullptr)) {
+                emit(level, std::forward<Callable>(make_message));
+            }
+        }
+
+        template<typename... Args>
+        void log(LogLevel level, std::string_view format_string, const Args &...args) {
+            if (not is_enabled(level)) {
+                record_filtered(level);
+                return;
+            }
+
+            if (admit(level, nullptr)) {
+                emit(level, format_string, args...);
+            }
+        }
+
+        // What the LOG_* macros call once the level check passed: like log(level, ...), but the rate limits and
+        // sampling also apply per call site, and only admitted messages are ever built
+        template<typename... Args>
+        void log_at(const CallSite &call_site, LogLevel level, Args &&...args) {
+            if (admit(level, &call_site)) {
+                emit(level, std::forward<Args>(args)...);
+            }
+        }
+
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void debug(Callable &&make_message) {
+            log(LogLevel::DEBUG, std::forward<Callable>(make_message));
+        }
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void info(Callable &&make_message) {
+            log(LogLevel::INFO, std::forward<Callable>(make_message));
+        }
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void warning(Callable &&make_message) {
+            log(LogLevel::WARNING, std::forward<Callable>(make_message));
+        }
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void error(Callable &&make_message) {
+            log(LogLevel::ERROR, std::forward<Callable>(make_message));
+        }
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void fatal(Callable &&make_message) {
+            log(LogLevel::FATAL, std::forward<Callable>(make_message));
+        }
+
+        template<typename Arg, typename... Args>
+        void debug(std::string_view format_string, const Arg &arg, const Args &...args) {
+            log(LogLevel::DEBUG, format_string, arg, args...);
+        }
+        template<typename Arg, typename... Args>
+        void info(std::string_view format_string, const Arg &arg, const Args &...args) {
+            log(LogLevel::INFO, format_string, arg, args...);
+        }
+        template<typename Arg, typename... Args>
+        void warning(std::string_view format_string, const Arg &arg, const Args &...args) {
+            log(LogLevel::WARNING, format_string, arg, args...);
+        }
+        template<typename Arg, typename... Args>
+        void error(std::string_view format_string, const Arg &arg, const Args &...args) {
+            log(LogLevel::ERROR, format_string, arg, args...);
+        }
+        template<typename Arg, typename... Args>
+        void fatal(std::string_view format_string, const Arg &arg, const Args &...args) {
+            log(LogLevel::FATAL, format_string, arg, args...);
+        }
+
+        // Blocks until every message accepted so far has been handed to the sinks, then flushes every sink
+        void flush();
+
         void set_default_level(LogLevel level);
         [[nodiscard]] LogLevel get_default_level() const;
 
+        // Cheap enough to be called before building the message
+        [[nodiscard]] bool is_enabled(LogLevel level) const {
+            return level >= default_level_.load(std::memory_order_relaxed);
+        }
+
+        // Counts a message the caller skipped after is_enabled() returned false (the LOG_* macros do this)
+        void record_filtered(LogLevel level) { filtered_.add(level); }
+
         [[nodiscard]] bool is_valid() const;
+        [[nodiscard]] bool is_async() const;
+
+        // Messages an asynchronous logger lost to its overflow policy; a synchronous logger never drops
+        [[nodiscard]] uint64_t dropped_count() const;
+        [[nodiscard]] uint64_t dropped_count(LogLevel level) const;
+
+        // Token-bucket limits and sampling applied after the level check; messages they reject are counted and
+        // summed up in a periodic WARNING line. May be changed at any time, also while logging; what the previous
+        // limits suppressed is summed up right after the change.
+        void set_rate_limits(const RateLimitOptions &options);
+        void clear_rate_limits();
+
+        // Snapshot of the counters the logger keeps about itself; safe to call while logging
+        [[nodiscard]] LoggerStats stats() const;
+        // Writes LoggerStats::describe() as an INFO line at most this often (zero, the default, disables it).
+        // An asynchronous logger writes it from the backend thread, a synchronous one from the next log() call.
+        void set_stats_interval(std::chrono::milliseconds interval);
 
     private:
         Logger(LogLevel default_level = LogLevel::INFO);
 
+        bool admit(LogLevel level, const CallSite *call_site) {
+            if (not rate_limited_.load(std::memory_order_relaxed)) {
+                return true;
+            }
+
+            auto limiter = std::atomic_load_explicit(&rate_limiter_, std::memory_order_acquire);
+            if (limiter == nullptr || limiter->admit(level, call_site)) {
+                return true;
+            }
+
+            // A fully throttled synchronous logger still owes its summary; the backend thread checks on its own
+            if (not queue_) {
+                report_suppressed(false);
+            }
+            return false;
+        }
+
+        // Build and write a message that passed every check
+        template<typename Callable, typename = std::enable_if_t<std::is_invocable_v<Callable &>>>
+        void emit(LogLevel level, Callable &&make_message) {
+            const auto &message = make_message();
+            write_message(std::string_view(message), level);
+        }
+
+        template<typename... Args>
+        void emit(LogLevel level, std::string_view format_string, const Args &...args) {
+            if constexpr (sizeof...(Args) == 0) {
+                write_message(format_string, level);
+            } else {
+                LogRecord record(level);
+                utility::format_to(record, format_string, args...);
+                write_record(std::move(record));
+            }
+        }
+
+        void write_message(std::string_view message, LogLevel level);
+        // The same for a message already built into a record; queued as is by an asynchronous logger
+        void write_record(LogRecord &&record);
+
+        void start_backend(const QueueOptions &queue_options);
+        void stop_backend();
+        // The backend's write step: runs the periodic reports, then formats and writes a batch taken off the queue
+        void write_backend_batch(std::vector<LogRecord> &records, size_t count);
+        // Writes a record DROP_OLDEST took off the queue but must not drop, from the calling thread
+        void write_evicted(LogRecord &&record);
+        // Writes the stats line once the stats interval has passed; any thread may call it, only one writes
+        void report_stats();
+        // The same for the summary of messages suppressed by the rate limits, or right away when `force`d
+        void report_suppressed(bool force);
+        // Makes the suppression summary due now, after the limiter was replaced or removed
+        void flush_suppressed();
+        // Deleter of every limiter: keeps what it suppressed once the last log() call using it is done
+        void retire_rate_limiter(RateLimiter *limiter);
+        void write_line(std::string_view text, LogLevel level);
+        void write_to_sinks(const SinkList &sinks, const std::vector<SinkMessage> &messages);
+        static void count_sink_write(const SinkEntry &entry, const std::vector<SinkMessage> &messages);
+        std::shared_ptr<const SinkList> load_sinks() const;
+        static bool has_valid_sink(const SinkList &sinks);
+
     private:
-        std::vector<std::unique_ptr<ILogSink>> sinks_;
-        LogLevel default_level_;
-        mutable std::mutex sinks_mutex_;
+        // Immutable snapshot, replaced as a whole by add_sink()/clear_sinks(): log() and is_valid() only load
+        // the pointer atomically and never take sinks_mutex_, which merely serializes the writers
+        std::shared_ptr<const SinkList> sinks_;
+        std::atomic<LogLevel> default_level_;
+        std::mutex sinks_mutex_;
+
+        // Async mode state
+        std::unique_ptr<BoundedQueue<LogRecord>> queue_;
+        // Backend thread only; formatted lines are kept across batches so their capacity is reused
+        std::vector<std::string> formatted_;
+        std::vector<SinkMessage> batch_;
+
+        // Self-instrumentation, see stats()
+        StripedLevelCounters accepted_;
+        StripedLevelCounters filtered_;
+        LatencyHistogram latency_;
+        std::atomic<int64_t> stats_interval_ms_{0};
+        // steady_clock time in nanoseconds
+        std::atomic<int64_t> next_stats_report_{0};
+
+        // Suppressed by limiters already retired, and their summaries not written yet; declared before
+        // rate_limiter_, whose deleter still fills them in while the logger is destroyed
+        DropCounters retired_suppressed_;
+        std::vector<std::string> retired_summaries_;
+        std::mutex retired_mutex_;
+        // Null without limits. Swapped like sinks_: log() loads the pointer atomically, and a replaced limiter is
+        // retired once the last call that loaded it is done.
+        std::shared_ptr<RateLimiter> rate_limiter_;
+        // Spares log() the shared_ptr load while there are no limits
+        std::atomic<bool> rate_limited_{false};
+        std::mutex rate_limiter_mutex_;
+        // steady_clock time in nanoseconds; INT64_MAX while no limiter reports
+        std::atomic<int64_t> next_suppressed_report_{std::numeric_limits<int64_t>::max()};
     };
 } // namespace logger
@@ -0,0 +1,133 @@
+#include "logger_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace logger {
+    namespace {
+        std::string format_duration(std::chrono::nanoseconds duration) {
+            auto nanoseconds = duration.count();
+            if (nanoseconds < 10'000) {
+                return std::to_string(nanoseconds) + "ns";
+            }
+            if (nanoseconds < 10'000'000) {
+                return std::to_string(nanoseconds / 1'000) + "us";
+            }
+            return std::to_string(nanoseconds / 1'000'000) + "ms";
+        }
+    } // namespace
+
+    StripedLevelCounters::Snapshot StripedLevelCounters::snapshot() const {
+        Snapshot result{};
+        for (const auto &stripe: stripes_) {
+            for (size_t i = 0; i < LEVEL_COUNT; ++i) {
+                result[i] += stripe.counts[i].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    size_t StripedLevelCounters::stripe_index() {
+        // Threads are spread over the stripes in the order they first log
+        static std::atomic<size_t> next_index{0};
+        thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % STRIPE_COUNT;
+        return index;
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+        auto nanoseconds = static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+        counts_[bucket_index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+
+        uint64_t max = max_nanoseconds_.load(std::memory_order_relaxed);
+        while (nanoseconds > max &&
+               not max_nanoseconds_.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+        Snapshot result;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+            result.total_count += result.counts[i];
+        }
+        result.max_nanoseconds = max_nanoseconds_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    size_t LatencyHistogram::bucket_index(uint64_t nanoseconds) {
+        if (nanoseconds < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(nanoseconds);
+        }
+
+        auto magnitude = static_cast<size_t>(63 - __builtin_clzll(nanoseconds));
+        if (magnitude > MAX_MAGNITUDE) {
+            return BUCKET_COUNT - 1;
+        }
+
+        // The top SUB_BUCKET_BITS + 1 bits, whose leading one is implied by the magnitude
+        size_t top = static_cast<size_t>(nanoseconds >> (magnitude - SUB_BUCKET_BITS));
+        return (magnitude - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + (top - SUB_BUCKET_COUNT);
+    }
+
+    uint64_t LatencyHistogram::bucket_upper_bound(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+
+        size_t magnitude = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+        uint64_t top = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+        return ((top + 1) << (magnitude - SUB_BUCKET_BITS)) - 1;
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::Snapshot::percentile(double percent) const {
+        if (total_count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+
+        auto rank = static_cast<uint64_t>(std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * total_count));
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                // Never report more than was actually observed
+                return std::chrono::nanoseconds(std::min(bucket_upper_bound(i), max_nanoseconds));
+            }
+        }
+        return max();
+    }
+
+    uint64_t LoggerStats::total(const LevelCounts &counts) {
+        uint64_t sum = 0;
+        for (auto count: counts) {
+            sum += count;
+        }
+        return sum;
+    }
+
+    std::string LoggerStats::describe() const {
+        std::string result = "Logger stats: accepted " + std::to_string(total(accepted)) + ", filtered " +
+                             std::to_string(total(filtered)) + ", dropped " + std::to_string(total(dropped));
+        if (total(suppressed) > 0) {
+            result += ", suppressed " + std::to_string(total(suppressed));
+        }
+
+        for (size_t i = 0; i < sinks.size(); ++i) {
+            result += ", sink " + std::to_string(i) + ": " + std::to_string(sinks[i].messages) + " messages " +
+                      std::to_string(sinks[i].bytes) + " bytes " + std::to_string(sinks[i].errors) + " errors";
+        }
+
+        if (queue_capacity > 0) {
+            result += ", queue high water " + std::to_string(queue_high_water_mark) + "/" +
+                      std::to_string(queue_capacity);
+        }
+
+        if (latency.total_count > 0) {
+            result += ", latency p50 " + format_duration(latency.percentile(50)) + " p99 " +
+                      format_duration(latency.percentile(99)) + " max " + format_duration(latency.max());
+        }
+
+        return result;
+    }
+} // namespace logger
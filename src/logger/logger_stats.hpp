@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "backpressure.hpp"
+#include "log_level.hpp"
+
+namespace logger {
+    // Per-level counters split into cache-line sized stripes picked by the calling thread, so threads logging
+    // at the same time do not bounce one counter between cores. Updates are relaxed; reads sum all stripes.
+    class StripedLevelCounters {
+    public:
+        static constexpr size_t LEVEL_COUNT = DropCounters::LEVEL_COUNT;
+        using Snapshot = DropCounters::Snapshot;
+
+        void add(LogLevel level, uint64_t count = 1) {
+            stripes_[stripe_index()].counts[static_cast<size_t>(level)].fetch_add(count, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] Snapshot snapshot() const;
+
+    private:
+        static constexpr size_t STRIPE_COUNT = 16;
+
+        struct alignas(64) Stripe {
+            std::array<std::atomic<uint64_t>, LEVEL_COUNT> counts{};
+        };
+
+        static size_t stripe_index();
+
+        std::array<Stripe, STRIPE_COUNT> stripes_{};
+    };
+
+    // HDR-style histogram of durations in nanoseconds: exact below 16ns, above that every power of two is split
+    // into 16 linear buckets, so any recorded value is known to within 1/16 (~6%) with a fixed 4.8 KiB of counters
+    class LatencyHistogram {
+    public:
+        static constexpr size_t SUB_BUCKET_BITS = 4;
+        static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+        // Values of 2^41ns (about 37 minutes) and more land in the last bucket
+        static constexpr size_t MAX_MAGNITUDE = 40;
+        // The exact buckets, then one group per power of two from 2^SUB_BUCKET_BITS to 2^MAX_MAGNITUDE
+        static constexpr size_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+        struct Snapshot {
+            std::array<uint64_t, BUCKET_COUNT> counts{};
+            uint64_t total_count = 0;
+            uint64_t max_nanoseconds = 0;
+
+            // Upper bound of the bucket holding the given percentile (0-100), 0 when nothing was recorded
+            [[nodiscard]] std::chrono::nanoseconds percentile(double percent) const;
+            [[nodiscard]] std::chrono::nanoseconds max() const { return std::chrono::nanoseconds(max_nanoseconds); }
+        };
+
+        void record(std::chrono::nanoseconds duration);
+        [[nodiscard]] Snapshot snapshot() const;
+
+        static size_t bucket_index(uint64_t nanoseconds);
+        // Largest value that falls into the bucket
+        static uint64_t bucket_upper_bound(size_t index);
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_{};
+        std::atomic<uint64_t> max_nanoseconds_{0};
+    };
+
+    // What a sink was handed by the Logger; shared by every copy of its SinkEntry
+    struct SinkCounters {
+        std::atomic<uint64_t> messages{0};
+        std::atomic<uint64_t> bytes{0};
+        // Messages handed to the sink while it reported itself invalid
+        std::atomic<uint64_t> errors{0};
+    };
+
+    // Point-in-time copy of a Logger's self-instrumentation, see Logger::stats()
+    struct LoggerStats {
+        using LevelCounts = DropCounters::Snapshot;
+
+        struct Sink {
+            uint64_t messages = 0;
+            uint64_t bytes = 0;
+            uint64_t errors = 0;
+        };
+
+        // Passed the level check
+        LevelCounts accepted{};
+        // Rejected by the level check
+        LevelCounts filtered{};
+        // Lost to the overflow policy of an asynchronous logger
+        LevelCounts dropped{};
+        // Rejected by the rate limits and sampling
+        LevelCounts suppressed{};
+        // In the order the sinks were added
+        std::vector<Sink> sinks;
+        // Asynchronous loggers only
+        size_t queue_capacity = 0;
+        size_t queue_high_water_mark = 0;
+        // From the moment a message was logged until its sinks returned from write_batch()
+        LatencyHistogram::Snapshot latency;
+
+        [[nodiscard]] static uint64_t total(const LevelCounts &counts);
+
+        // One-line summary, e.g. "Logger stats: accepted 1200, filtered 30, dropped 0, sink 0: 1200 messages
+        // 96000 bytes 0 errors, queue high water 57/8192, latency p50 12us p99 85us max 310us"
+        [[nodiscard]] std::string describe() const;
+    };
+} // namespace logger
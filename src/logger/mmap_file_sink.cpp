@@ -0,0 +1,253 @@
+#include "mmap_file_sink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace logger {
+    MmapFileSink::MmapFileSink(const std::string &filename, size_t segment_size) :
+        filename_(filename), segment_size_(std::max<size_t>(segment_size, 2)) {
+        if (filename_.empty()) {
+            return;
+        }
+
+        segment_ = open_segment(next_free_index(0));
+        healthy_.store(segment_ != nullptr, std::memory_order_release);
+
+        if (segment_) {
+            retire_thread_ = std::thread(&MmapFileSink::retire_thread_function, this);
+        }
+    }
+
+    MmapFileSink::~MmapFileSink() {
+        {
+            std::lock_guard<std::mutex> lock(retire_mutex_);
+            stopping_ = true;
+            retire_condition_.notify_all();
+        }
+
+        // Finishes the segments already handed over before it exits
+        if (retire_thread_.joinable()) {
+            retire_thread_.join();
+        }
+
+        std::unique_lock<std::shared_mutex> lock(segment_mutex_);
+        if (segment_) {
+            close_segment(*segment_);
+        }
+    }
+
+    void MmapFileSink::write(std::string_view message) {
+        if (not is_valid()) {
+            return;
+        }
+
+        std::string_view parts[2] = {message, "\n"};
+        write_parts(parts, 2, message.size() + 1);
+    }
+
+    void MmapFileSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid() || messages.empty()) {
+            return;
+        }
+
+        // Reserve the whole batch at once; fall back to per-line writes if it cannot fit in one segment
+        std::vector<std::string_view> parts;
+        parts.reserve(messages.size() * 2);
+        size_t total_size = 0;
+        for (const auto &message: messages) {
+            parts.push_back(message.text);
+            parts.push_back("\n");
+            total_size += message.text.size() + 1;
+        }
+
+        if (total_size <= segment_size_) {
+            write_parts(parts.data(), parts.size(), total_size);
+            return;
+        }
+
+        for (size_t i = 0; i < parts.size(); i += 2) {
+            write_parts(&parts[i], 2, parts[i].size() + 1);
+        }
+    }
+
+    void MmapFileSink::flush() {
+        std::shared_lock<std::shared_mutex> lock(segment_mutex_);
+        if (segment_) {
+            size_t used = std::min(segment_->cursor.load(std::memory_order_acquire), segment_->size);
+            msync(segment_->data, used, MS_ASYNC);
+        }
+    }
+
+    bool MmapFileSink::is_valid() const { return healthy_.load(std::memory_order_acquire); }
+
+    std::string MmapFileSink::current_segment_path() const {
+        std::shared_lock<std::shared_mutex> lock(segment_mutex_);
+        return segment_ ? segment_->path : std::string();
+    }
+
+    void MmapFileSink::wait_for_retirements() {
+        std::unique_lock<std::mutex> lock(retire_mutex_);
+        retire_done_condition_.wait(lock, [this] { return retiring_.empty() && not retire_in_progress_; });
+    }
+
+    size_t MmapFileSink::next_free_index(size_t index) const {
+        // Never overwrite a segment left by a previous run
+        struct stat st;
+        while (stat((filename_ + "." + std::to_string(index)).c_str(), &st) == 0) {
+            ++index;
+        }
+        return index;
+    }
+
+    std::unique_ptr<MmapFileSink::Segment> MmapFileSink::open_segment(size_t index) {
+        auto segment = std::make_unique<Segment>();
+        segment->index = index;
+        segment->path = filename_ + "." + std::to_string(index);
+        segment->size = segment_size_;
+        segment->data_end.store(segment_size_, std::memory_order_relaxed);
+
+        segment->fd = open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (segment->fd == -1) {
+            std::cerr << "[MmapFileSink] Failed to open " << segment->path << ": " << strerror(errno) << std::endl;
+            return nullptr;
+        }
+
+        // Allocate real blocks: writing into a sparse mapping on a full disk would raise SIGBUS
+        int error = posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->size));
+        if (error != 0) {
+            std::cerr << "[MmapFileSink] Failed to preallocate " << segment->path << ": " << strerror(error)
+                      << std::endl;
+            close(segment->fd);
+            return nullptr;
+        }
+
+        void *data = mmap(nullptr, segment->size, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "[MmapFileSink] Failed to map " << segment->path << ": " << strerror(errno) << std::endl;
+            close(segment->fd);
+            return nullptr;
+        }
+
+        segment->data = static_cast<char *>(data);
+        return segment;
+    }
+
+    void MmapFileSink::close_segment(Segment &segment) {
+        size_t used = std::min({segment.cursor.load(std::memory_order_acquire),
+                                segment.data_end.load(std::memory_order_acquire), segment.size});
+
+        msync(segment.data, segment.size, MS_SYNC);
+        munmap(segment.data, segment.size);
+
+        // Trim the preallocated tail so the closed segment ends with the last complete line
+        if (ftruncate(segment.fd, static_cast<off_t>(used)) == -1) {
+            std::cerr << "[MmapFileSink] Failed to trim " << segment.path << ": " << strerror(errno) << std::endl;
+        }
+        close(segment.fd);
+
+        segment.data = nullptr;
+        segment.fd = -1;
+    }
+
+    bool MmapFileSink::try_write(Segment &segment, const std::string_view *parts, size_t count, size_t total_size) {
+        size_t offset = segment.cursor.fetch_add(total_size, std::memory_order_acq_rel);
+
+        if (offset + total_size > segment.size) {
+            size_t data_end = segment.data_end.load(std::memory_order_relaxed);
+            while (offset < data_end &&
+                   not segment.data_end.compare_exchange_weak(data_end, offset, std::memory_order_acq_rel)) {
+            }
+            return false;
+        }
+
+        char *out = segment.data + offset;
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(out, parts[i].data(), parts[i].size());
+            out += parts[i].size();
+        }
+        return true;
+    }
+
+    void MmapFileSink::write_parts(const std::string_view *parts, size_t count, size_t total_size) {
+        std::string truncated;
+        if (total_size > segment_size_) {
+            // A single line longer than a whole segment is cut to fit
+            for (size_t i = 0; i < count; ++i) {
+                truncated.append(parts[i]);
+            }
+            truncated.resize(segment_size_ - 1);
+            truncated.push_back('\n');
+            std::string_view part = truncated;
+            write_parts(&part, 1, part.size());
+            return;
+        }
+
+        while (is_valid()) {
+            size_t full_segment_index;
+            {
+                std::shared_lock<std::shared_mutex> lock(segment_mutex_);
+                if (not segment_) {
+                    return;
+                }
+                if (try_write(*segment_, parts, count, total_size)) {
+                    return;
+                }
+                full_segment_index = segment_->index;
+            }
+
+            rollover(full_segment_index);
+        }
+    }
+
+    void MmapFileSink::rollover(size_t full_segment_index) {
+        std::unique_lock<std::shared_mutex> lock(segment_mutex_);
+
+        // Another writer may have already switched segments
+        if (not segment_ || segment_->index != full_segment_index) {
+            return;
+        }
+
+        // Writers reach the segment only through segment_ under the shared lock, so once it is swapped out
+        // nobody else touches the old mapping and it can be closed without holding the lock
+        std::unique_ptr<Segment> full = std::move(segment_);
+        segment_ = open_segment(next_free_index(full_segment_index + 1));
+
+        if (not segment_) {
+            healthy_.store(false, std::memory_order_release);
+        }
+        lock.unlock();
+
+        std::lock_guard<std::mutex> retire_lock(retire_mutex_);
+        retiring_.push_back(std::move(full));
+        retire_condition_.notify_one();
+    }
+
+    void MmapFileSink::retire_thread_function() {
+        std::unique_lock<std::mutex> lock(retire_mutex_);
+
+        while (true) {
+            retire_condition_.wait(lock, [this] { return stopping_ || not retiring_.empty(); });
+            if (retiring_.empty()) {
+                break;
+            }
+
+            std::unique_ptr<Segment> segment = std::move(retiring_.front());
+            retiring_.pop_front();
+            retire_in_progress_ = true;
+
+            lock.unlock();
+            close_segment(*segment);
+            lock.lock();
+
+            retire_in_progress_ = false;
+            retire_done_condition_.notify_all();
+        }
+    }
+} // namespace logger
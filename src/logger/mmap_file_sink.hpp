@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include "sink.hpp"
+
+namespace logger {
+    // Writes lines into a preallocated, memory-mapped file. Producers reserve space with an atomic cursor and
+    // memcpy into the mapping; the kernel writes the pages back, so there is no syscall per message and data
+    // already copied survives a crash of the process.
+    //
+    // Data goes to segments named "<filename>.<index>". When a segment is full the next one is swapped in, and a
+    // background thread syncs the full one, unmaps it and trims it to its used size, so writers never wait for
+    // that I/O. After a crash the active segment keeps its NUL padding after the last line.
+    class MmapFileSink : public ILogSink {
+    public:
+        static constexpr size_t DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024;
+
+    public:
+        explicit MmapFileSink(const std::string &filename, size_t segment_size = DEFAULT_SEGMENT_SIZE);
+        ~MmapFileSink() override;
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        void flush() override;
+        bool is_valid() const override;
+
+        [[nodiscard]] std::string current_segment_path() const;
+
+        // Blocks until every full segment has been synced, unmapped and trimmed
+        void wait_for_retirements();
+
+    private:
+        struct Segment {
+            size_t index = 0;
+            std::string path;
+            int fd = -1;
+            char *data = nullptr;
+            size_t size = 0;
+            std::atomic<size_t> cursor{0};
+            // Offset of the first reservation that did not fit; everything before it is written
+            std::atomic<size_t> data_end{0};
+        };
+
+        size_t next_free_index(size_t index) const;
+        std::unique_ptr<Segment> open_segment(size_t index);
+        void close_segment(Segment &segment);
+        // Tries to copy all parts as one contiguous block; returns false if the segment was full
+        bool try_write(Segment &segment, const std::string_view *parts, size_t count, size_t total_size);
+        void write_parts(const std::string_view *parts, size_t count, size_t total_size);
+        void rollover(size_t full_segment_index);
+        void retire_thread_function();
+
+    private:
+        std::string filename_;
+        size_t segment_size_;
+        std::atomic<bool> healthy_{false};
+
+        // Shared by writers copying into the mapping, exclusive while switching segments
+        mutable std::shared_mutex segment_mutex_;
+        std::unique_ptr<Segment> segment_;
+
+        // Full segments waiting for the background thread
+        std::mutex retire_mutex_;
+        std::condition_variable retire_condition_;
+        std::condition_variable retire_done_condition_;
+        std::deque<std::unique_ptr<Segment>> retiring_;
+        bool retire_in_progress_ = false;
+        bool stopping_ = false;
+        std::thread retire_thread_;
+    };
+} // namespace logger
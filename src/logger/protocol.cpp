@@ -0,0 +1,137 @@
+#include "protocol.hpp"
+
+#include <cstring>
+#include <endian.h>
+
+namespace logger {
+    namespace protocol {
+        namespace {
+            enum class DecodeResult { OK, INCOMPLETE, CORRUPT };
+
+            DecodeResult decode(const char *data, size_t size, Frame &frame) {
+                if (size < HEADER_SIZE) {
+                    return DecodeResult::INCOMPLETE;
+                }
+
+                uint16_t magic;
+                uint32_t length;
+                uint64_t time;
+                std::memcpy(&magic, data, sizeof(magic));
+                std::memcpy(&length, data + 4, sizeof(length));
+                std::memcpy(&time, data + 8, sizeof(time));
+                magic = be16toh(magic);
+                length = be32toh(length);
+                time = be64toh(time);
+
+                auto level = static_cast<uint8_t>(data[3]);
+                if (magic != MAGIC || static_cast<uint8_t>(data[2]) != VERSION ||
+                    level > static_cast<uint8_t>(LogLevel::FATAL) || length > MAX_PAYLOAD_SIZE) {
+                    return DecodeResult::CORRUPT;
+                }
+
+                if (size < HEADER_SIZE + length) {
+                    return DecodeResult::INCOMPLETE;
+                }
+
+                frame.level = static_cast<LogLevel>(level);
+                frame.timestamp = std::chrono::system_clock::time_point(
+                        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                std::chrono::microseconds(static_cast<int64_t>(time))));
+                frame.payload = std::string_view(data + HEADER_SIZE, length);
+                return DecodeResult::OK;
+            }
+        } // namespace
+
+        void encode_header(char *header, LogLevel level, std::chrono::system_clock::time_point timestamp,
+                           size_t payload_size) {
+            uint16_t magic = htobe16(MAGIC);
+            uint32_t length = htobe32(static_cast<uint32_t>(payload_size));
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch());
+            uint64_t time = htobe64(static_cast<uint64_t>(micros.count()));
+
+            std::memcpy(header, &magic, sizeof(magic));
+            header[2] = static_cast<char>(VERSION);
+            header[3] = static_cast<char>(level);
+            std::memcpy(header + 4, &length, sizeof(length));
+            std::memcpy(header + 8, &time, sizeof(time));
+        }
+
+        std::string encode_frame(std::string_view payload, LogLevel level,
+                                 std::chrono::system_clock::time_point timestamp) {
+            std::string frame(HEADER_SIZE + payload.size(), '\0');
+            encode_header(frame.data(), level, timestamp, payload.size());
+            std::memcpy(frame.data() + HEADER_SIZE, payload.data(), payload.size());
+            return frame;
+        }
+
+        void FrameDecoder::feed(const char *data, size_t size) {
+            // Drop consumed bytes before growing, so a partial frame is moved to the front at most once per feed
+            if (read_position_ > 0) {
+                buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(read_position_));
+                read_position_ = 0;
+            }
+
+            buffer_.insert(buffer_.end(), data, data + size);
+        }
+
+        bool decode_frame(std::string_view data, Frame &frame) {
+            return decode(data.data(), data.size(), frame) == DecodeResult::OK;
+        }
+
+        void encode_datagram_header(char *header, uint32_t first_sequence) {
+            uint16_t magic = htobe16(DATAGRAM_MAGIC);
+            uint32_t sequence = htobe32(first_sequence);
+
+            std::memcpy(header, &magic, sizeof(magic));
+            header[2] = static_cast<char>(VERSION);
+            header[3] = 0;
+            std::memcpy(header + 4, &sequence, sizeof(sequence));
+        }
+
+        bool decode_datagram_header(std::string_view datagram, uint32_t &first_sequence) {
+            if (datagram.size() < DATAGRAM_HEADER_SIZE) {
+                return false;
+            }
+
+            uint16_t magic;
+            uint32_t sequence;
+            std::memcpy(&magic, datagram.data(), sizeof(magic));
+            std::memcpy(&sequence, datagram.data() + 4, sizeof(sequence));
+
+            if (be16toh(magic) != DATAGRAM_MAGIC || static_cast<uint8_t>(datagram[2]) != VERSION) {
+                return false;
+            }
+
+            first_sequence = be32toh(sequence);
+            return true;
+        }
+
+        bool FrameDecoder::next(Frame &frame) {
+            if (error_) {
+                return false;
+            }
+
+            DecodeResult result = decode(buffer_.data() + read_position_, buffered_bytes(), frame);
+            if (result == DecodeResult::CORRUPT) {
+                error_ = true;
+                return false;
+            }
+            if (result == DecodeResult::INCOMPLETE) {
+                return false; // wait for the rest of the frame
+            }
+
+            read_position_ += HEADER_SIZE + frame.payload.size();
+            return true;
+        }
+
+        bool FrameDecoder::has_error() const { return error_; }
+
+        size_t FrameDecoder::buffered_bytes() const { return buffer_.size() - read_position_; }
+
+        void FrameDecoder::reset() {
+            buffer_.clear();
+            read_position_ = 0;
+            error_ = false;
+        }
+    } // namespace protocol
+} // namespace logger
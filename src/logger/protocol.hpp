@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "log_level.hpp"
+
+namespace logger {
+    // Wire format used by SocketSink. Every log line travels as one frame:
+    //
+    //   offset  size  field
+    //        0     2  magic "LG"
+    //        2     1  version
+    //        3     1  level
+    //        4     4  payload length
+    //        8     8  timestamp, microseconds since the Unix epoch
+    //       16     n  payload (the formatted line)
+    //
+    // All integers are big-endian.
+    //
+    // Over UDP a datagram carries one or more whole frames after an 8-byte datagram header:
+    //
+    //   offset  size  field
+    //        0     2  magic "LD"
+    //        2     1  version
+    //        3     1  reserved, zero
+    //        4     4  sequence number of the first message, counted per sender and wrapping around
+    //
+    // Receivers detect lost messages from gaps in the sequence numbers.
+    namespace protocol {
+        constexpr uint16_t MAGIC = 0x4C47;
+        constexpr uint8_t VERSION = 1;
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t MAX_PAYLOAD_SIZE = 16 * 1024 * 1024;
+
+        constexpr uint16_t DATAGRAM_MAGIC = 0x4C44;
+        constexpr size_t DATAGRAM_HEADER_SIZE = 8;
+        // Largest payload of an IPv4 UDP datagram
+        constexpr size_t MAX_DATAGRAM_SIZE = 65507;
+
+        struct Frame {
+            LogLevel level = LogLevel::INFO;
+            std::chrono::system_clock::time_point timestamp;
+            // Points into the decoder's buffer, valid until the next feed()
+            std::string_view payload;
+        };
+
+        void encode_header(char *header, LogLevel level, std::chrono::system_clock::time_point timestamp,
+                           size_t payload_size);
+
+        // Header and payload as a single buffer, e.g. for storing a frame until it can be sent
+        [[nodiscard]] std::string encode_frame(std::string_view payload, LogLevel level,
+                                               std::chrono::system_clock::time_point timestamp);
+
+        // Decodes the frame at the start of `data`, e.g. a record that is known to hold exactly one frame;
+        // returns false if it is corrupt or incomplete. The payload points into `data`.
+        bool decode_frame(std::string_view data, Frame &frame);
+
+        void encode_datagram_header(char *header, uint32_t first_sequence);
+        // Returns false if `datagram` does not start with a valid datagram header
+        bool decode_datagram_header(std::string_view datagram, uint32_t &first_sequence);
+
+        // Reassembles frames from a byte stream that may split or merge them arbitrarily
+        class FrameDecoder {
+        public:
+            void feed(const char *data, size_t size);
+
+            // Returns false if no complete frame is buffered or the stream is corrupt
+            bool next(Frame &frame);
+
+            [[nodiscard]] bool has_error() const;
+            [[nodiscard]] size_t buffered_bytes() const;
+            void reset();
+
+        private:
+            std::vector<char> buffer_;
+            size_t read_position_ = 0;
+            bool error_ = false;
+        };
+    } // namespace protocol
+} // namespace logger
@@ -0,0 +1,173 @@
+#include "rate_limiter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+namespace logger {
+    namespace {
+        int64_t steady_now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+        }
+
+        // xorshift64* per thread: sampling must not add a shared cache line or a lock to the logging path
+        double random_unit() {
+            thread_local uint64_t state =
+                    (std::hash<std::thread::id>()(std::this_thread::get_id()) ^ static_cast<uint64_t>(steady_now())) |
+                    1;
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            uint64_t value = state * 0x2545F4914F6CDD1DULL;
+            return static_cast<double>(value >> 11) * 0x1.0p-53;
+        }
+
+        std::string_view file_name(std::string_view path) {
+            size_t slash = path.find_last_of('/');
+            return slash == std::string_view::npos ? path : path.substr(slash + 1);
+        }
+    } // namespace
+
+    RateLimiter::RateLimiter(const RateLimitOptions &options) :
+        options_(options), call_site_bucket_(make_bucket(options.per_call_site)),
+        site_slots_(std::make_unique<SiteSlot[]>(SITE_SLOT_COUNT)) {
+        for (size_t i = 0; i < RateLimitOptions::LEVEL_COUNT; ++i) {
+            level_buckets_[i] = make_bucket(options_.per_level[i]);
+        }
+    }
+
+    bool RateLimiter::admit(LogLevel level, const CallSite *call_site) {
+        if (level >= options_.exempt_level) {
+            return true;
+        }
+
+        auto index = static_cast<size_t>(level);
+        bool keep = true;
+
+        uint32_t every_nth = options_.every_nth[index];
+        if (every_nth > 1 && level_sequence_[index].fetch_add(1, std::memory_order_relaxed) % every_nth != 0) {
+            keep = false;
+        }
+
+        double probability = options_.sample_probability[index];
+        if (keep && probability < 1.0 && random_unit() >= probability) {
+            keep = false;
+        }
+
+        // Sampling goes first, so sampled-out messages do not use up tokens
+        const Bucket &level_bucket = level_buckets_[index];
+        SiteSlot *slot = nullptr;
+        if (keep && call_site != nullptr && call_site_bucket_.interval > 0) {
+            slot = find_slot(call_site);
+        }
+        if (keep && (level_bucket.interval > 0 || slot)) {
+            int64_t now = steady_now();
+            if (slot && not take(slot->bucket, call_site_bucket_, now)) {
+                keep = false;
+            } else if (level_bucket.interval > 0 && not take(level_state_[index], level_bucket, now)) {
+                keep = false;
+                // A message the level limit rejects must not use up the budget of its call site as well
+                if (slot) {
+                    refund(slot->bucket, call_site_bucket_);
+                }
+            }
+        }
+
+        if (keep) {
+            return true;
+        }
+
+        suppressed_.add(level);
+        if (call_site != nullptr && (slot || (slot = find_slot(call_site)))) {
+            slot->suppressed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    std::string RateLimiter::describe_suppressed() {
+        auto current = suppressed_.snapshot();
+        uint64_t total = 0;
+        std::string details = DropCounters::describe_levels(current, reported_, total);
+        reported_ = current;
+
+        const CallSite *busiest = nullptr;
+        uint64_t busiest_count = 0;
+        for (size_t i = 0; i < SITE_SLOT_COUNT; ++i) {
+            const CallSite *site = site_slots_[i].site.load(std::memory_order_acquire);
+            if (site == nullptr) {
+                continue;
+            }
+
+            uint64_t count = site_slots_[i].suppressed.exchange(0, std::memory_order_relaxed);
+            if (count > busiest_count) {
+                busiest = site;
+                busiest_count = count;
+            }
+        }
+
+        if (total == 0) {
+            return {};
+        }
+
+        std::string result = "Suppressed " + std::to_string(total) + " messages by rate limits and sampling (" +
+                             details + ")";
+        if (busiest) {
+            result += ", busiest call site " + std::string(file_name(busiest->file)) + ":" +
+                      std::to_string(busiest->line) + " (" + std::to_string(busiest_count) + ")";
+        }
+        return result;
+    }
+
+    RateLimiter::Bucket RateLimiter::make_bucket(const RateLimit &limit) {
+        if (limit.per_second <= 0) {
+            return {};
+        }
+
+        Bucket bucket;
+        bucket.interval = std::max<int64_t>(static_cast<int64_t>(std::llround(1e9 / limit.per_second)), 1);
+        bucket.burst = bucket.interval * std::max<int64_t>(static_cast<int64_t>(limit.burst), 1);
+        return bucket;
+    }
+
+    bool RateLimiter::take(std::atomic<int64_t> &state, const Bucket &bucket, int64_t now) {
+        // GCRA: `state` is when the bucket would be full again. A message fits while that stays within one
+        // burst from now, which is a token bucket kept in a single word.
+        int64_t full_at = state.load(std::memory_order_relaxed);
+        while (true) {
+            int64_t next = std::max(full_at, now) + bucket.interval;
+            if (next - now > bucket.burst) {
+                return false;
+            }
+            if (state.compare_exchange_weak(full_at, next, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    void RateLimiter::refund(std::atomic<int64_t> &state, const Bucket &bucket) {
+        state.fetch_sub(bucket.interval, std::memory_order_relaxed);
+    }
+
+    RateLimiter::SiteSlot *RateLimiter::find_slot(const CallSite *call_site) {
+        // Fibonacci hashing of the address; sites are statics, so the low bits carry little
+        auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(call_site)) * 0x9E3779B97F4A7C15ULL;
+        auto start = static_cast<size_t>(hash >> 54);
+        static_assert(SITE_SLOT_COUNT == size_t{1} << 10, "the hash keeps 10 bits");
+
+        for (size_t probe = 0; probe < SITE_SLOT_COUNT; ++probe) {
+            SiteSlot &slot = site_slots_[(start + probe) % SITE_SLOT_COUNT];
+            const CallSite *owner = slot.site.load(std::memory_order_acquire);
+            if (owner == nullptr && slot.site.compare_exchange_strong(owner, call_site, std::memory_order_acq_rel)) {
+                return &slot;
+            }
+            if (owner == call_site) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+} // namespace logger
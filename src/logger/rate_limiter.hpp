@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "backpressure.hpp"
+#include "log_level.hpp"
+
+namespace logger {
+    // Token bucket: on average `per_second` messages pass, with up to `burst` of them at once
+    struct RateLimit {
+        // Zero disables the limit
+        double per_second = 0;
+        double burst = 1;
+    };
+
+    struct RateLimitOptions {
+        static constexpr size_t LEVEL_COUNT = DropCounters::LEVEL_COUNT;
+
+        RateLimitOptions() { sample_probability.fill(1.0); }
+
+        // Shared by every message of the level
+        std::array<RateLimit, LEVEL_COUNT> per_level{};
+        // A bucket of its own for every LOG_* call site, whatever the level
+        RateLimit per_call_site;
+        // Keep only the first of every N messages of the level (0 and 1 keep all)
+        std::array<uint32_t, LEVEL_COUNT> every_nth{};
+        // Keep each message of the level with this probability
+        std::array<double, LEVEL_COUNT> sample_probability{};
+        // Messages at this level or above are never limited or sampled
+        LogLevel exempt_level = LogLevel::FATAL;
+        // How often suppressed messages are summed up in a synthetic WARNING line; zero disables the report
+        std::chrono::milliseconds report_interval{5000};
+    };
+
+    // Identifies one LOG_* statement; the macros keep one as a function-local constexpr static, so it costs
+    // nothing on the logging path. The bucket and counts of a statement live in each RateLimiter, keyed by address.
+    struct CallSite {
+        constexpr CallSite(const char *file, int line) : file(file), line(line) {}
+
+        const char *const file;
+        const int line;
+    };
+
+    // Decides which messages pass the configured limits and counts the ones that do not. All checks are lock-free.
+    class RateLimiter {
+    public:
+        explicit RateLimiter(const RateLimitOptions &options);
+
+        // Returns false if the message is to be suppressed; `call_site` may be null
+        bool admit(LogLevel level, const CallSite *call_site);
+
+        [[nodiscard]] const RateLimitOptions &options() const { return options_; }
+        [[nodiscard]] const DropCounters &suppressed() const { return suppressed_; }
+
+        // "Suppressed 1200 messages by rate limits and sampling (DEBUG: 1000, INFO: 200), busiest call site
+        // main.cpp:42 (900)" for what was suppressed since the previous call, or an empty string.
+        // Calls must not overlap.
+        [[nodiscard]] std::string describe_suppressed();
+
+    private:
+        struct Bucket {
+            // Nanoseconds one message takes from the bucket, zero when unlimited
+            int64_t interval = 0;
+            int64_t burst = 0;
+        };
+
+        // Per-call-site state, claimed by the first message of the site this limiter sees
+        struct SiteSlot {
+            std::atomic<const CallSite *> site{nullptr};
+            // steady_clock nanoseconds at which the bucket is full again (GCRA theoretical arrival time)
+            std::atomic<int64_t> bucket{0};
+            // Suppressed since the previous summary
+            std::atomic<uint64_t> suppressed{0};
+        };
+
+        // Open addressing over a fixed table, so sites are found without a lock and never move. Sites beyond
+        // the table are not limited per call site and not named in the summary; the level limits still apply.
+        static constexpr size_t SITE_SLOT_COUNT = 1024;
+
+        static Bucket make_bucket(const RateLimit &limit);
+        static bool take(std::atomic<int64_t> &state, const Bucket &bucket, int64_t now);
+        // Gives back what a successful take() used up
+        static void refund(std::atomic<int64_t> &state, const Bucket &bucket);
+
+        SiteSlot *find_slot(const CallSite *call_site);
+
+    private:
+        RateLimitOptions options_;
+        std::array<Bucket, RateLimitOptions::LEVEL_COUNT> level_buckets_;
+        Bucket call_site_bucket_;
+        std::array<std::atomic<int64_t>, RateLimitOptions::LEVEL_COUNT> level_state_{};
+        std::array<std::atomic<uint64_t>, RateLimitOptions::LEVEL_COUNT> level_sequence_{};
+        std::unique_ptr<SiteSlot[]> site_slots_;
+
+        DropCounters suppressed_;
+        DropCounters::Snapshot reported_{};
+    };
+} // namespace logger
@@ -0,0 +1,219 @@
+#include "raw_file_sink.hpp"
+
+#include "crash_handler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+namespace logger {
+    RawFileSink::RawFileSink(const std::string &filename, const RawFileSinkOptions &options) :
+        fd_(-1), options_(options) {
+        buffer_capacity_ = (std::max<size_t>(options_.buffer_size, 1) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+        buffer_.reset(static_cast<char *>(std::aligned_alloc(PAGE_SIZE, buffer_capacity_)));
+
+        if (not buffer_ || not open_file(filename)) {
+            return;
+        }
+
+        healthy_.store(true, std::memory_order_release);
+
+        if (options_.flush_on_crash) {
+            crash_handle_ = CrashHandler::register_buffer(fd_, buffer_.get(), &buffer_used_, &buffer_written_);
+        }
+
+        if (options_.flush_policy.flush_interval.count() > 0) {
+            flush_thread_ = std::thread(&RawFileSink::flush_thread_function, this);
+        }
+    }
+
+    RawFileSink::~RawFileSink() {
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            stopping_ = true;
+            flush_condition_.notify_all();
+        }
+
+        if (flush_thread_.joinable()) {
+            flush_thread_.join();
+        }
+
+        CrashHandler::unregister_buffer(crash_handle_);
+
+        if (fd_ != -1) {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            flush_buffer();
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void RawFileSink::write(std::string_view message) {
+        if (not is_valid()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        append(message);
+
+        if (buffer_used_.load(std::memory_order_relaxed) >= options_.flush_policy.max_buffered_bytes) {
+            flush_buffer();
+        }
+    }
+
+    void RawFileSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid()) {
+            return;
+        }
+
+        bool urgent = false;
+
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        for (const auto &message: messages) {
+            append(message.text);
+            urgent = urgent || message.level >= options_.flush_policy.flush_level;
+        }
+
+        if (urgent || buffer_used_.load(std::memory_order_relaxed) >= options_.flush_policy.max_buffered_bytes) {
+            flush_buffer();
+        }
+    }
+
+    void RawFileSink::flush() {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        flush_buffer();
+    }
+
+    bool RawFileSink::is_valid() const { return healthy_.load(std::memory_order_acquire); }
+
+    bool RawFileSink::open_file(const std::string &filename) {
+        if (filename.empty()) {
+            return false;
+        }
+
+        fd_ = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ == -1) {
+            std::cerr << "[RawFileSink] Failed to open " << filename << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        off_t end = lseek(fd_, 0, SEEK_END);
+        writeback_end_ = dropped_end_ = std::max<off_t>(end, 0);
+
+        if (options_.preallocate_bytes > 0) {
+            // KEEP_SIZE reserves blocks without moving the end of file, so appends land in the reserved space
+            if (end == -1 || fallocate(fd_, FALLOC_FL_KEEP_SIZE, end, options_.preallocate_bytes) == -1) {
+                std::cerr << "[RawFileSink] Preallocation failed: " << strerror(errno) << std::endl;
+            }
+        }
+
+        return true;
+    }
+
+    void RawFileSink::flush_thread_function() {
+        std::unique_lock<std::mutex> lock(buffer_mutex_);
+
+        while (not stopping_) {
+            flush_condition_.wait_for(lock, options_.flush_policy.flush_interval);
+            flush_buffer();
+        }
+    }
+
+    void RawFileSink::append(std::string_view message) {
+        size_t line_size = message.size() + 1;
+
+        if (buffer_used_.load(std::memory_order_relaxed) + line_size > buffer_capacity_) {
+            flush_buffer();
+        }
+
+        if (line_size > buffer_capacity_) {
+            // Too large to buffer: write straight through, skipping the copy
+            char newline = '\n';
+            iovec iovecs[2] = {{const_cast<char *>(message.data()), message.size()}, {&newline, 1}};
+            write_all(iovecs, 2);
+            return;
+        }
+
+        // The line is complete before the crash handler can see it
+        size_t used = buffer_used_.load(std::memory_order_relaxed);
+        std::memcpy(buffer_.get() + used, message.data(), message.size());
+        buffer_.get()[used + message.size()] = '\n';
+        buffer_used_.store(used + line_size, std::memory_order_release);
+    }
+
+    void RawFileSink::flush_buffer() {
+        size_t used = buffer_used_.load(std::memory_order_relaxed);
+        if (used == 0 || fd_ == -1) {
+            return;
+        }
+
+        // A signal in the middle leaves the crash handler only what write(2) has not taken yet, apart from the
+        // chunk in flight (see write_all). used is cleared before written, so the handler never sees the whole
+        // flushed buffer as pending again.
+        iovec iov{buffer_.get(), used};
+        write_all(&iov, 1, &buffer_written_);
+        buffer_used_.store(0, std::memory_order_release);
+        buffer_written_.store(0, std::memory_order_release);
+
+        if (options_.drop_page_cache) {
+            release_page_cache();
+        }
+    }
+
+    void RawFileSink::release_page_cache() {
+        // With O_APPEND the file position follows the end of file after every write
+        off_t end = lseek(fd_, 0, SEEK_CUR);
+        if (end <= writeback_end_) {
+            return;
+        }
+
+        // DONTNEED skips dirty pages, so right after the write it would do nothing. The new range only has its
+        // writeback started here and is dropped one flush later, once the disk had the time in between.
+        sync_file_range(fd_, writeback_end_, end - writeback_end_, SYNC_FILE_RANGE_WRITE);
+        if (writeback_end_ > dropped_end_) {
+            posix_fadvise(fd_, dropped_end_, writeback_end_ - dropped_end_, POSIX_FADV_DONTNEED);
+            dropped_end_ = writeback_end_;
+        }
+        writeback_end_ = end;
+    }
+
+    bool RawFileSink::write_all(iovec *iovecs, size_t count, std::atomic<size_t> *progress) {
+        while (count > 0) {
+            ssize_t written = writev(fd_, iovecs, static_cast<int>(count));
+
+            if (written == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "[RawFileSink] Write failed: " << strerror(errno) << std::endl;
+                healthy_.store(false, std::memory_order_release);
+                return false;
+            }
+
+            // A signal between writev() returning and this update makes the crash handler write the chunk again.
+            // Advancing first instead would lose it when the signal came before writev(), so a crash may
+            // duplicate at most the bytes of one writev() call, never drop them.
+            if (progress) {
+                progress->fetch_add(static_cast<size_t>(written), std::memory_order_release);
+            }
+
+            size_t remaining = static_cast<size_t>(written);
+            while (count > 0 && remaining >= iovecs->iov_len) {
+                remaining -= iovecs->iov_len;
+                ++iovecs;
+                --count;
+            }
+            if (count > 0 && remaining > 0) {
+                iovecs->iov_base = static_cast<char *>(iovecs->iov_base) + remaining;
+                iovecs->iov_len -= remaining;
+            }
+        }
+
+        return true;
+    }
+} // namespace logger
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sys/uio.h>
+
+#include "flush_policy.hpp"
+#include "sink.hpp"
+
+namespace logger {
+    struct RawFileSinkOptions {
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+
+        // Size of the user-space buffer, rounded up to a whole number of pages
+        size_t buffer_size = DEFAULT_BUFFER_SIZE;
+        FlushPolicy flush_policy{DEFAULT_BUFFER_SIZE, std::chrono::milliseconds(1000), LogLevel::ERROR};
+        // Reserve this much disk space past the current end of file up front (fallocate, 0 = disabled)
+        size_t preallocate_bytes = 0;
+        // Keep the log out of the page cache: each flush starts writeback of what it wrote (sync_file_range) and
+        // drops the range written by the flush before, whose pages are clean by then (POSIX_FADV_DONTNEED)
+        bool drop_page_cache = false;
+        // Register the buffer with the CrashHandler, so a fatal signal does not lose what is still buffered.
+        // A signal landing in the middle of a flush may write part of the buffer twice, never lose it.
+        bool flush_on_crash = true;
+    };
+
+    // File sink writing through a raw O_APPEND descriptor from a large aligned buffer, without iostreams.
+    // Health is tracked in an atomic flag, so is_valid() never takes the buffer lock.
+    class RawFileSink : public ILogSink {
+    public:
+        explicit RawFileSink(const std::string &filename, const RawFileSinkOptions &options = RawFileSinkOptions());
+        ~RawFileSink() override;
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        void flush() override;
+        bool is_valid() const override;
+
+    private:
+        struct FreeDeleter {
+            void operator()(char *ptr) const { std::free(ptr); }
+        };
+
+        static constexpr size_t PAGE_SIZE = 4096;
+
+        bool open_file(const std::string &filename);
+        void flush_thread_function();
+
+        // The following expect buffer_mutex_ to be held
+        void append(std::string_view message);
+        void flush_buffer();
+        // Advances `progress`, when given, by every chunk write(2) took
+        bool write_all(iovec *iovecs, size_t count, std::atomic<size_t> *progress = nullptr);
+        void release_page_cache();
+
+    private:
+        int fd_;
+        RawFileSinkOptions options_;
+        std::atomic<bool> healthy_{false};
+
+        std::mutex buffer_mutex_;
+        std::unique_ptr<char, FreeDeleter> buffer_;
+        size_t buffer_capacity_;
+        // Only changed under buffer_mutex_; atomic because the crash handler reads it without the lock
+        std::atomic<size_t> buffer_used_{0};
+        // How much of the buffer flush_buffer() already wrote out, for the same reason
+        std::atomic<size_t> buffer_written_{0};
+        int crash_handle_ = -1;
+
+        // File offsets for drop_page_cache: writeback was started up to writeback_end_, pages below
+        // dropped_end_ were already dropped
+        off_t writeback_end_ = 0;
+        off_t dropped_end_ = 0;
+
+        std::thread flush_thread_;
+        std::condition_variable flush_condition_;
+        bool stopping_ = false;
+    };
+} // namespace logger
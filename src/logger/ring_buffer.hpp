@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace logger {
+    // Bounded lock-free queue (Vyukov). Every cell carries a sequence number, so producers only contend on one
+    // atomic increment and never block each other on I/O. The dequeue side uses the same CAS scheme, which keeps
+    // it safe to pop from more than one thread.
+    template<typename T>
+    class RingBuffer {
+    public:
+        explicit RingBuffer(size_t capacity) : capacity_(round_up_to_power_of_two(capacity)), mask_(capacity_ - 1) {
+            cells_ = std::make_unique<Cell[]>(capacity_);
+            for (size_t i = 0; i < capacity_; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        template<typename U>
+        bool try_push(U &&item) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+            while (true) {
+                Cell &cell = cells_[pos & mask_];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.data = std::forward<U>(item);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // full
+                } else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool try_pop(T &item) {
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+            while (true) {
+                Cell &cell = cells_[pos & mask_];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+
+                if (diff == 0) {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        item = std::move(cell.data);
+                        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false; // empty
+                } else {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        size_t capacity() const { return capacity_; }
+
+        // Approximate while producers or consumers are active
+        size_t size() const {
+            size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+            size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static size_t round_up_to_power_of_two(size_t value) {
+            size_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    private:
+        const size_t capacity_;
+        const size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos_{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos_{0};
+    };
+} // namespace logger
@@ -0,0 +1,300 @@
+#include "rotating_file_sink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace logger {
+    RotatingFileSink::RotatingFileSink(const std::string &filename, const RotationPolicy &policy) :
+        filename_(filename), policy_(policy), fd_(-1) {
+        if (filename_.empty()) {
+            return;
+        }
+
+        recover_pending_files();
+
+        fd_ = open(filename_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ == -1) {
+            std::cerr << "[RotatingFileSink] Failed to open " << filename_ << ": " << strerror(errno) << std::endl;
+            return;
+        }
+
+        struct stat st;
+        if (fstat(fd_, &st) == 0) {
+            bytes_written_ = static_cast<size_t>(st.st_size);
+        }
+        opened_at_ = std::chrono::steady_clock::now();
+
+        healthy_.store(true, std::memory_order_release);
+        background_thread_ = std::thread(&RotatingFileSink::background_thread_function, this);
+    }
+
+    RotatingFileSink::~RotatingFileSink() {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            stopping_ = true;
+            jobs_condition_.notify_all();
+        }
+
+        if (background_thread_.joinable()) {
+            background_thread_.join();
+        }
+
+        if (prepared_.fd != -1) {
+            close(prepared_.fd);
+            unlink(prepared_.path.c_str());
+        }
+
+        if (fd_ != -1) {
+            close(fd_);
+        }
+    }
+
+    void RotatingFileSink::write(std::string_view message) {
+        if (not is_valid()) {
+            return;
+        }
+
+        std::vector<iovec> iovecs{{const_cast<char *>(message.data()), message.size()},
+                                  {const_cast<char *>("\n"), 1}};
+        write_iovecs(iovecs, message.size() + 1);
+    }
+
+    void RotatingFileSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid() || messages.empty()) {
+            return;
+        }
+
+        std::vector<iovec> iovecs;
+        iovecs.reserve(messages.size() * 2);
+        size_t total_size = 0;
+        for (const auto &message: messages) {
+            iovecs.push_back(iovec{const_cast<char *>(message.text.data()), message.text.size()});
+            iovecs.push_back(iovec{const_cast<char *>("\n"), 1});
+            total_size += message.text.size() + 1;
+        }
+
+        write_iovecs(iovecs, total_size);
+    }
+
+    bool RotatingFileSink::is_valid() const { return healthy_.load(std::memory_order_acquire); }
+
+    void RotatingFileSink::wait_for_rotations() {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        jobs_done_condition_.wait(lock, [this] { return (jobs_.empty() && not job_in_progress_) || stopping_; });
+    }
+
+    void RotatingFileSink::write_iovecs(std::vector<iovec> &iovecs, size_t total_size) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+
+        if (should_rotate(total_size)) {
+            rotate();
+        }
+
+        iovec *current = iovecs.data();
+        size_t count = iovecs.size();
+
+        while (count > 0) {
+            ssize_t written = writev(fd_, current, static_cast<int>(std::min(count, MAX_IOVECS_PER_WRITE)));
+
+            if (written == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                std::cerr << "[RotatingFileSink] Write failed: " << strerror(errno) << std::endl;
+                healthy_.store(false, std::memory_order_release);
+                return;
+            }
+
+            size_t remaining = static_cast<size_t>(written);
+            while (count > 0 && remaining >= current->iov_len) {
+                remaining -= current->iov_len;
+                ++current;
+                --count;
+            }
+            if (count > 0 && remaining > 0) {
+                current->iov_base = static_cast<char *>(current->iov_base) + remaining;
+                current->iov_len -= remaining;
+            }
+        }
+
+        bytes_written_ += total_size;
+    }
+
+    bool RotatingFileSink::should_rotate(size_t incoming_size) const {
+        if (bytes_written_ == 0) {
+            return false;
+        }
+
+        if (policy_.max_bytes > 0 && bytes_written_ + incoming_size > policy_.max_bytes) {
+            return true;
+        }
+
+        return policy_.max_age.count() > 0 && std::chrono::steady_clock::now() - opened_at_ >= policy_.max_age;
+    }
+
+    void RotatingFileSink::rotate() {
+        PreparedFile next;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            std::swap(next, prepared_);
+        }
+
+        // The background thread normally has the next file ready; only open one here if it fell behind
+        if (next.fd == -1) {
+            next = open_pending_file();
+            if (next.fd == -1) {
+                return; // keep writing to the current file
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_.push_back(RotationJob{fd_, next.path});
+            jobs_condition_.notify_one();
+        }
+
+        fd_ = next.fd;
+        bytes_written_ = 0;
+        opened_at_ = std::chrono::steady_clock::now();
+    }
+
+    RotatingFileSink::PreparedFile RotatingFileSink::open_pending_file() {
+        // O_EXCL: a name that is already taken is skipped, never truncated
+        PreparedFile file;
+        for (size_t attempt = 0; attempt < MAX_PENDING_ATTEMPTS; ++attempt) {
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                file.path = filename_ + ".pending." + std::to_string(pending_sequence_++);
+            }
+
+            file.fd = open(file.path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644);
+            if (file.fd != -1 || errno != EEXIST) {
+                break;
+            }
+        }
+
+        if (file.fd == -1) {
+            std::cerr << "[RotatingFileSink] Failed to create " << file.path << ": " << strerror(errno) << std::endl;
+        }
+        return file;
+    }
+
+    void RotatingFileSink::recover_pending_files() {
+        namespace fs = std::filesystem;
+
+        fs::path base(filename_);
+        fs::path directory = base.has_parent_path() ? base.parent_path() : fs::path(".");
+        std::string prefix = base.filename().string() + ".pending.";
+
+        // Left behind by a crash: the prepared file, which is empty, and files that had already taken over from
+        // <filename> before their rotation was finalized. These hold the newest lines, in sequence order.
+        std::map<size_t, fs::path> leftovers;
+        std::error_code ec;
+        for (const auto &entry: fs::directory_iterator(directory, ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() <= prefix.size() || name.rfind(prefix, 0) != 0) {
+                continue;
+            }
+
+            std::string number = name.substr(prefix.size());
+            if (not std::all_of(number.begin(), number.end(), [](unsigned char c) { return std::isdigit(c); })) {
+                continue;
+            }
+            leftovers.emplace(std::stoull(number), entry.path());
+        }
+
+        for (const auto &[sequence, path]: leftovers) {
+            if (fs::file_size(path, ec) == 0 || ec) {
+                fs::remove(path, ec);
+                continue;
+            }
+
+            std::cerr << "[RotatingFileSink] Recovering " << path.string() << " left by an earlier run" << std::endl;
+            if (fs::exists(filename_, ec)) {
+                shift_archives();
+            }
+            std::rename(path.c_str(), filename_.c_str());
+        }
+    }
+
+    void RotatingFileSink::background_thread_function() {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+
+        while (true) {
+            if (not jobs_.empty()) {
+                RotationJob job = std::move(jobs_.front());
+                jobs_.pop_front();
+                job_in_progress_ = true;
+
+                lock.unlock();
+                finalize_rotation(job);
+                lock.lock();
+
+                job_in_progress_ = false;
+                jobs_done_condition_.notify_all();
+                continue;
+            }
+
+            if (stopping_) {
+                break;
+            }
+
+            if (prepared_.fd == -1) {
+                lock.unlock();
+                PreparedFile file = open_pending_file();
+                lock.lock();
+
+                if (prepared_.fd == -1) {
+                    prepared_ = std::move(file);
+                } else if (file.fd != -1) {
+                    close(file.fd);
+                    unlink(file.path.c_str());
+                }
+                continue;
+            }
+
+            jobs_condition_.wait(lock, [this] { return not jobs_.empty() || stopping_ || prepared_.fd == -1; });
+        }
+
+        jobs_done_condition_.notify_all();
+    }
+
+    void RotatingFileSink::finalize_rotation(const RotationJob &job) {
+        fsync(job.old_fd);
+        close(job.old_fd);
+
+        shift_archives();
+        std::rename(job.new_file_path.c_str(), filename_.c_str());
+    }
+
+    void RotatingFileSink::shift_archives() {
+        size_t last = 1;
+        struct stat st;
+        while (stat(archive_path(last).c_str(), &st) == 0) {
+            ++last;
+        }
+
+        if (policy_.max_files > 0 && last > policy_.max_files) {
+            for (size_t index = policy_.max_files; index < last; ++index) {
+                unlink(archive_path(index).c_str());
+            }
+            last = policy_.max_files;
+        }
+
+        for (size_t index = last; index > 1; --index) {
+            std::rename(archive_path(index - 1).c_str(), archive_path(index).c_str());
+        }
+
+        std::rename(filename_.c_str(), archive_path(1).c_str());
+    }
+
+    std::string RotatingFileSink::archive_path(size_t index) const { return filename_ + "." + std::to_string(index); }
+} // namespace logger
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sys/uio.h>
+
+#include "sink.hpp"
+
+namespace logger {
+    struct RotationPolicy {
+        // Rotate once the active file reaches this size (0 = no size limit)
+        size_t max_bytes = 0;
+        // Rotate once the active file has been open this long (0 = no age limit)
+        std::chrono::seconds max_age{0};
+        // Archived files to keep as "<filename>.1" (newest) ... "<filename>.N" (0 = keep all)
+        size_t max_files = 0;
+    };
+
+    // Appends to "<filename>" and rotates it by size and/or age. The writing thread only swaps in a file that a
+    // background thread has already created; fsync, closing, renaming and deleting old archives all happen on
+    // that background thread, so a rotation never blocks the writer on disk I/O.
+    class RotatingFileSink : public ILogSink {
+    public:
+        RotatingFileSink(const std::string &filename, const RotationPolicy &policy);
+        ~RotatingFileSink() override;
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        bool is_valid() const override;
+
+        // Blocks until all pending rotations have been finalized
+        void wait_for_rotations();
+
+    private:
+        static constexpr size_t MAX_IOVECS_PER_WRITE = 1024;
+        // Taken "<filename>.pending.N" names skipped before giving up on a new file
+        static constexpr size_t MAX_PENDING_ATTEMPTS = 64;
+
+        struct PreparedFile {
+            int fd = -1;
+            std::string path;
+        };
+
+        struct RotationJob {
+            int old_fd;
+            std::string new_file_path;
+        };
+
+        void write_iovecs(std::vector<iovec> &iovecs, size_t total_size);
+        // Expect write_mutex_ to be held
+        bool should_rotate(size_t incoming_size) const;
+        void rotate();
+
+        PreparedFile open_pending_file();
+        // Moves pending files a crashed run left behind into the archive chain; called before opening <filename>
+        void recover_pending_files();
+        void background_thread_function();
+        void finalize_rotation(const RotationJob &job);
+        // <filename>.N-1 -> <filename>.N, ..., <filename> -> <filename>.1, dropping archives beyond max_files
+        void shift_archives();
+        std::string archive_path(size_t index) const;
+
+    private:
+        std::string filename_;
+        RotationPolicy policy_;
+        std::atomic<bool> healthy_{false};
+
+        std::mutex write_mutex_;
+        int fd_;
+        size_t bytes_written_ = 0;
+        std::chrono::steady_clock::time_point opened_at_;
+
+        // Background finalization
+        std::mutex jobs_mutex_;
+        std::condition_variable jobs_condition_;
+        std::condition_variable jobs_done_condition_;
+        std::deque<RotationJob> jobs_;
+        PreparedFile prepared_;
+        size_t pending_sequence_ = 0;
+        bool job_in_progress_ = false;
+        bool stopping_ = false;
+        std::thread background_thread_;
+    };
+} // namespace logger
@@ -0,0 +1,353 @@
+#include "shm_ring.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace logger {
+    // Lives at the start of the shared memory object, followed by the data area. Fields written by producers,
+    // by the reader and for wakeups sit on separate cache lines.
+    struct ShmRing::Header {
+        static constexpr uint32_t MAGIC = 0x4C475348; // "LGSH"
+        static constexpr uint32_t VERSION = 1;
+
+        // Stored last by the creator, so a producer never maps a half-initialized ring
+        std::atomic<uint32_t> magic;
+        uint32_t version;
+        uint64_t capacity;
+        // Set by the reader when it goes away; producers stop writing into an object nobody reads any more
+        std::atomic<uint32_t> closed;
+
+        alignas(64) std::atomic<uint64_t> write_position;
+        std::atomic<uint64_t> dropped;
+
+        alignas(64) std::atomic<uint64_t> read_position;
+
+        alignas(64) std::atomic<uint32_t> reader_waiting;
+        std::atomic<uint32_t> wake_sequence;
+    };
+
+    struct ShmRing::RecordHeader {
+        static constexpr uint32_t EMPTY = 0;
+        static constexpr uint32_t DATA = 1;
+        // Fills the tail of the data area when a record would wrap around
+        static constexpr uint32_t PADDING = 2;
+
+        std::atomic<uint32_t> state;
+        uint32_t length;
+    };
+
+    namespace {
+        static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+                      "shared memory atomics must be lock-free to work across processes");
+
+        constexpr size_t RECORD_ALIGNMENT = 8;
+        constexpr size_t MIN_CAPACITY = 4096;
+
+        size_t align_record(size_t size) { return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1); }
+
+        size_t round_up_to_power_of_two(size_t value) {
+            size_t result = MIN_CAPACITY;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        // Plain futex on a word shared between processes, hence no FUTEX_PRIVATE_FLAG
+        void futex_wait(std::atomic<uint32_t> *word, uint32_t expected, std::chrono::milliseconds timeout) {
+            timespec ts{};
+            ts.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+            ts.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+        }
+
+        void futex_wake(std::atomic<uint32_t> *word) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+        }
+
+        ino_t inode_of(int fd) {
+            struct stat st{};
+            return fstat(fd, &st) == 0 ? st.st_ino : 0;
+        }
+    } // namespace
+
+    std::unique_ptr<ShmRing> ShmRing::create(const std::string &name, size_t capacity) {
+        std::string object = object_name(name);
+        capacity = round_up_to_power_of_two(capacity);
+        size_t mapped_size = sizeof(Header) + capacity;
+
+        // A ring left behind by a crashed reader may still be mapped by producers; tell them it is gone, then
+        // start over with a fresh one
+        close_linked_ring(object);
+        shm_unlink(object.c_str());
+
+        int fd = shm_open(object.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+        if (fd == -1) {
+            std::cerr << "[ShmRing] Failed to create " << object << ": " << strerror(errno) << std::endl;
+            return nullptr;
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(mapped_size)) == -1) {
+            std::cerr << "[ShmRing] Failed to resize " << object << ": " << strerror(errno) << std::endl;
+            close(fd);
+            shm_unlink(object.c_str());
+            return nullptr;
+        }
+
+        ino_t inode = inode_of(fd);
+        void *memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            std::cerr << "[ShmRing] Failed to map " << object << ": " << strerror(errno) << std::endl;
+            shm_unlink(object.c_str());
+            return nullptr;
+        }
+
+        // ftruncate() zero-fills, which is the initial state of every field and every record
+        auto *header = new (memory) Header;
+        header->version = Header::VERSION;
+        header->capacity = capacity;
+        header->magic.store(Header::MAGIC, std::memory_order_release);
+
+        return std::unique_ptr<ShmRing>(new ShmRing(std::move(object), memory, mapped_size, true, inode));
+    }
+
+    std::unique_ptr<ShmRing> ShmRing::open(const std::string &name) {
+        std::string object = object_name(name);
+
+        int fd = shm_open(object.c_str(), O_RDWR, 0);
+        if (fd == -1) {
+            std::cerr << "[ShmRing] Failed to open " << object << ": " << strerror(errno) << std::endl;
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+            std::cerr << "[ShmRing] " << object << " is not a log ring" << std::endl;
+            close(fd);
+            return nullptr;
+        }
+
+        auto mapped_size = static_cast<size_t>(st.st_size);
+        ino_t inode = st.st_ino;
+        void *memory = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            std::cerr << "[ShmRing] Failed to map " << object << ": " << strerror(errno) << std::endl;
+            return nullptr;
+        }
+
+        auto *header = static_cast<Header *>(memory);
+        if (header->magic.load(std::memory_order_acquire) != Header::MAGIC || header->version != Header::VERSION ||
+            sizeof(Header) + header->capacity != mapped_size) {
+            std::cerr << "[ShmRing] " << object << " is not a log ring" << std::endl;
+            munmap(memory, mapped_size);
+            return nullptr;
+        }
+
+        return std::unique_ptr<ShmRing>(new ShmRing(std::move(object), memory, mapped_size, false, inode));
+    }
+
+    bool ShmRing::is_shm_address(std::string_view address) {
+        return address.substr(0, ADDRESS_PREFIX.size()) == ADDRESS_PREFIX;
+    }
+
+    std::string ShmRing::object_name(std::string_view address) {
+        if (is_shm_address(address)) {
+            address.remove_prefix(ADDRESS_PREFIX.size());
+        }
+
+        std::string name;
+        if (address.empty() || address.front() != '/') {
+            name = "/";
+        }
+        name.append(address);
+        return name;
+    }
+
+    ShmRing::ShmRing(std::string name, void *memory, size_t mapped_size, bool owner, ino_t inode) :
+        name_(std::move(name)), memory_(memory), mapped_size_(mapped_size), owner_(owner), inode_(inode),
+        header_(static_cast<Header *>(memory)), data_(static_cast<char *>(memory) + sizeof(Header)),
+        capacity_(header_->capacity) {}
+
+    ShmRing::~ShmRing() {
+        if (owner_) {
+            header_->closed.store(1, std::memory_order_release);
+            // A newer reader may have taken the name over since; its ring is not ours to remove
+            if (is_linked()) {
+                shm_unlink(name_.c_str());
+            }
+        }
+        munmap(memory_, mapped_size_);
+    }
+
+    bool ShmRing::try_write(const std::string_view *parts, size_t count) {
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) {
+            length += parts[i].size();
+        }
+
+        size_t record_size = align_record(sizeof(RecordHeader) + length);
+        if (record_size > capacity_) {
+            header_->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t position = header_->write_position.load(std::memory_order_relaxed);
+        size_t padding;
+        do {
+            size_t offset = position & (capacity_ - 1);
+            padding = offset + record_size > capacity_ ? capacity_ - offset : 0;
+
+            // Acquire pairs with the reader's release, so the space handed back is seen zeroed
+            uint64_t read_position = header_->read_position.load(std::memory_order_acquire);
+            if (position + padding + record_size - read_position > capacity_) {
+                header_->dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (not header_->write_position.compare_exchange_weak(position, position + padding + record_size,
+                                                                   std::memory_order_relaxed));
+
+        if (padding > 0) {
+            RecordHeader *filler = record_at(position);
+            filler->length = static_cast<uint32_t>(padding);
+            filler->state.store(RecordHeader::PADDING, std::memory_order_release);
+        }
+
+        RecordHeader *record = record_at(position + padding);
+        char *destination = reinterpret_cast<char *>(record + 1);
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(destination, parts[i].data(), parts[i].size());
+            destination += parts[i].size();
+        }
+        record->length = static_cast<uint32_t>(length);
+        record->state.store(RecordHeader::DATA, std::memory_order_release);
+
+        wake_reader();
+        return true;
+    }
+
+    size_t ShmRing::read(const std::function<void(std::string_view)> &callback, size_t max_records) {
+        uint64_t position = header_->read_position.load(std::memory_order_relaxed);
+        size_t consumed = 0;
+
+        while (consumed < max_records) {
+            RecordHeader *record = record_at(position);
+            uint32_t state = record->state.load(std::memory_order_acquire);
+            if (state == RecordHeader::EMPTY) {
+                break; // next record is not committed yet
+            }
+
+            size_t size = record->length;
+            if (state == RecordHeader::DATA) {
+                callback(std::string_view(reinterpret_cast<const char *>(record + 1), size));
+                size = align_record(sizeof(RecordHeader) + size);
+                ++consumed;
+            }
+
+            // Zeroed space is what lets producers commit by storing the state alone
+            std::memset(reinterpret_cast<char *>(record + 1), 0, size - sizeof(RecordHeader));
+            record->length = 0;
+            record->state.store(RecordHeader::EMPTY, std::memory_order_relaxed);
+
+            position += size;
+            header_->read_position.store(position, std::memory_order_release);
+        }
+
+        return consumed;
+    }
+
+    bool ShmRing::wait(std::chrono::milliseconds timeout) {
+        if (not empty()) {
+            return true;
+        }
+
+        // Eventcount: take the sequence first, then announce the wait and re-check, so a commit either is seen
+        // here or sees reader_waiting and bumps the sequence, which makes FUTEX_WAIT return at once
+        uint32_t sequence = header_->wake_sequence.load(std::memory_order_seq_cst);
+        header_->reader_waiting.store(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (empty() && not interrupted_.load(std::memory_order_seq_cst)) {
+            futex_wait(&header_->wake_sequence, sequence, timeout);
+        }
+
+        header_->reader_waiting.store(0, std::memory_order_relaxed);
+        return not empty();
+    }
+
+    void ShmRing::interrupt() {
+        // The flag covers a reader that has not taken the sequence yet, the bump one that already has
+        interrupted_.store(true, std::memory_order_seq_cst);
+        header_->wake_sequence.fetch_add(1, std::memory_order_seq_cst);
+        futex_wake(&header_->wake_sequence);
+    }
+
+    bool ShmRing::empty() const {
+        uint64_t position = header_->read_position.load(std::memory_order_relaxed);
+        return record_at(position)->state.load(std::memory_order_acquire) == RecordHeader::EMPTY;
+    }
+
+    bool ShmRing::is_closed() const { return header_->closed.load(std::memory_order_acquire) != 0; }
+
+    void ShmRing::close_linked_ring(const std::string &object) {
+        int fd = shm_open(object.c_str(), O_RDWR, 0);
+        if (fd == -1) {
+            return;
+        }
+
+        struct stat st{};
+        void *memory = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(Header)) {
+            memory = mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) {
+            return;
+        }
+
+        auto *header = static_cast<Header *>(memory);
+        if (header->magic.load(std::memory_order_acquire) == Header::MAGIC) {
+            header->closed.store(1, std::memory_order_release);
+        }
+        munmap(memory, sizeof(Header));
+    }
+
+    bool ShmRing::is_linked() const {
+        int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd == -1) {
+            return false;
+        }
+
+        bool linked = inode_of(fd) == inode_;
+        close(fd);
+        return linked;
+    }
+
+    size_t ShmRing::capacity() const { return capacity_; }
+
+    uint64_t ShmRing::dropped_count() const { return header_->dropped.load(std::memory_order_relaxed); }
+
+    const std::string &ShmRing::name() const { return name_; }
+
+    ShmRing::RecordHeader *ShmRing::record_at(uint64_t position) const {
+        return reinterpret_cast<RecordHeader *>(data_ + (position & (capacity_ - 1)));
+    }
+
+    void ShmRing::wake_reader() {
+        // Only a parked reader costs a syscall; otherwise committing stays entirely in user space
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header_->reader_waiting.load(std::memory_order_relaxed) != 0) {
+            header_->wake_sequence.fetch_add(1, std::memory_order_seq_cst);
+            futex_wake(&header_->wake_sequence);
+        }
+    }
+} // namespace logger
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace logger {
+    // Multi-producer single-consumer byte ring in a POSIX shared memory object, used to ship log frames to a
+    // collector on the same host without sockets. The collector creates the object, any number of producers in
+    // any number of processes open it by name.
+    //
+    // Producers reserve space with a CAS on the shared write position, copy the record in and publish it by
+    // storing its header state last, so writing never blocks and never enters the kernel unless the reader is
+    // parked. The reader consumes records in reservation order and zeroes them before handing the space back,
+    // so a zero state always means "not committed yet". When the ring is full the record is dropped and counted.
+    //
+    // A producer that dies between reserving and committing a record stalls the reader at that record.
+    class ShmRing {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 16 * 1024 * 1024;
+        static constexpr std::string_view ADDRESS_PREFIX = "shm:";
+
+        // Reader side: creates (or recreates) the object; it is unlinked again when the ring is destroyed. A ring
+        // left under the name by a reader that crashed is marked closed first, so its producers move over.
+        // The capacity is rounded up to a power of two. Returns nullptr on failure.
+        [[nodiscard]] static std::unique_ptr<ShmRing> create(const std::string &name,
+                                                             size_t capacity = DEFAULT_CAPACITY);
+        // Producer side: maps an object created by a reader; returns nullptr if there is none
+        [[nodiscard]] static std::unique_ptr<ShmRing> open(const std::string &name);
+
+        // "shm:<name>" addresses select the shared memory transport
+        [[nodiscard]] static bool is_shm_address(std::string_view address);
+        // Strips the "shm:" prefix and makes sure the name starts with '/', as shm_open() expects
+        [[nodiscard]] static std::string object_name(std::string_view address);
+
+        ~ShmRing();
+
+        ShmRing(const ShmRing &) = delete;
+        ShmRing &operator=(const ShmRing &) = delete;
+
+        // Producer: copies the parts into one record; returns false (and counts a drop) if it does not fit
+        bool try_write(const std::string_view *parts, size_t count);
+
+        // Reader: passes up to max_records committed records to the callback, returns how many were consumed.
+        // The view is only valid during the callback.
+        size_t read(const std::function<void(std::string_view)> &callback, size_t max_records = SIZE_MAX);
+        // Reader: parks on a futex until a producer commits a record or the timeout expires;
+        // returns whether a record is ready
+        bool wait(std::chrono::milliseconds timeout);
+        // Wakes a reader parked in wait() at once and keeps later calls from parking; for shutting it down.
+        // May be called from any thread of the reader's process.
+        void interrupt();
+
+        [[nodiscard]] bool empty() const;
+        // Set once the reader has destroyed its ring; producers still mapping it should stop writing
+        [[nodiscard]] bool is_closed() const;
+        [[nodiscard]] size_t capacity() const;
+        // Records producers could not fit into the ring, over all processes
+        [[nodiscard]] uint64_t dropped_count() const;
+        [[nodiscard]] const std::string &name() const;
+
+    private:
+        struct Header;
+        struct RecordHeader;
+
+        ShmRing(std::string name, void *memory, size_t mapped_size, bool owner, ino_t inode);
+
+        // Sets the closed flag of whatever ring is linked under `object`, without reporting missing ones
+        static void close_linked_ring(const std::string &object);
+
+        // Whether the name still refers to the object this ring maps
+        [[nodiscard]] bool is_linked() const;
+
+        RecordHeader *record_at(uint64_t position) const;
+        void wake_reader();
+
+    private:
+        std::string name_;
+        void *memory_;
+        size_t mapped_size_;
+        bool owner_;
+        ino_t inode_;
+
+        Header *header_;
+        char *data_;
+        size_t capacity_;
+        std::atomic<bool> interrupted_{false};
+    };
+} // namespace logger
@@ -0,0 +1,95 @@
+#include "shm_sink.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+#include "protocol.hpp"
+
+namespace logger {
+    ShmSink::ShmSink(const std::string &name, const ShmSinkOptions &options) :
+        name_(name), options_(options), ring_(ShmRing::open(name)), backoff_(options.initial_backoff) {
+        healthy_ = ring_ != nullptr;
+    }
+
+    void ShmSink::write(std::string_view message) {
+        write_batch({SinkMessage{message, LogLevel::INFO, std::chrono::system_clock::now()}});
+    }
+
+    void ShmSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not healthy_) {
+            return;
+        }
+
+        std::shared_ptr<ShmRing> ring = current_ring();
+        if (not ring) {
+            lost_count_.fetch_add(messages.size(), std::memory_order_relaxed);
+            return;
+        }
+
+        char header[protocol::HEADER_SIZE];
+        for (const auto &message: messages) {
+            protocol::encode_header(header, message.level, message.timestamp, message.text.size());
+
+            std::string_view parts[] = {std::string_view(header, sizeof(header)), message.text};
+            ring->try_write(parts, 2);
+        }
+    }
+
+    bool ShmSink::is_valid() const {
+        if (not healthy_) {
+            return false;
+        }
+        if (options_.reconnect) {
+            return true;
+        }
+
+        std::shared_ptr<ShmRing> ring = std::atomic_load(&ring_);
+        return ring && not ring->is_closed();
+    }
+
+    uint64_t ShmSink::dropped_count() const {
+        std::shared_ptr<ShmRing> ring = std::atomic_load(&ring_);
+        return (ring ? ring->dropped_count() : 0) + lost_count_.load(std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<ShmRing> ShmSink::current_ring() {
+        std::shared_ptr<ShmRing> ring = std::atomic_load(&ring_);
+        if (ring && not ring->is_closed()) {
+            return ring;
+        }
+        if (not options_.reconnect) {
+            return nullptr;
+        }
+
+        std::unique_lock<std::mutex> lock(reopen_mutex_, std::try_to_lock);
+        if (not lock.owns_lock()) {
+            return nullptr;
+        }
+
+        // Another writer may have re-opened it meanwhile
+        ring = std::atomic_load(&ring_);
+        if (ring && not ring->is_closed()) {
+            return ring;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now < next_attempt_) {
+            return nullptr;
+        }
+
+        ring = ShmRing::open(name_);
+        if (ring && ring->is_closed()) {
+            ring.reset();
+        }
+        // Writers still holding the old ring keep its mapping until they are done
+        std::atomic_store(&ring_, ring);
+
+        if (ring) {
+            backoff_ = options_.initial_backoff;
+        } else {
+            next_attempt_ = now + backoff_;
+            backoff_ = std::min(backoff_ * 2, options_.max_backoff);
+        }
+        return ring;
+    }
+} // namespace logger
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "shm_ring.hpp"
+#include "sink.hpp"
+
+namespace logger {
+    struct ShmSinkOptions {
+        // Re-open the ring once the collector closes it or replaces it with a new one, instead of giving up
+        bool reconnect = true;
+        std::chrono::milliseconds initial_backoff{100};
+        std::chrono::milliseconds max_backoff{30000};
+    };
+
+    // Ships every message as a protocol frame through a ShmRing created by a collector on the same host.
+    // Writing is a memcpy into shared memory and never blocks: messages that do not fit are dropped and counted
+    // in the ring. Once the collector closes the ring (a restarted collector closes the one it replaces), the
+    // next write re-opens it by name, retrying with backoff; messages written until then are dropped.
+    class ShmSink : public ILogSink {
+    public:
+        // `name` is a shared memory object name, with or without the "shm:" prefix. The sink is invalid if no
+        // ring exists yet.
+        explicit ShmSink(const std::string &name, const ShmSinkOptions &options = ShmSinkOptions());
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        bool is_valid() const override;
+
+        // Messages dropped by all producers of the current ring because it was full, plus the ones this sink
+        // dropped while it had no open ring
+        [[nodiscard]] uint64_t dropped_count() const;
+
+    private:
+        // The ring to write into, re-opened if the current one is closed and a retry is due; null if none
+        std::shared_ptr<ShmRing> current_ring();
+
+    private:
+        std::string name_;
+        ShmSinkOptions options_;
+        bool healthy_;
+
+        // Swapped with atomic_load/atomic_store; writers hold a copy while they write
+        std::shared_ptr<ShmRing> ring_;
+
+        // Only one writer re-opens at a time, the others drop their messages meanwhile
+        std::mutex reopen_mutex_;
+        std::chrono::steady_clock::time_point next_attempt_;
+        std::chrono::milliseconds backoff_;
+
+        std::atomic<uint64_t> lost_count_{0};
+    };
+} // namespace logger
@@ -1,12 +1,35 @@
 #pragma once
 
+#include <chrono>
 #include <string_view>
+#include <vector>
+
+#include "log_level.hpp"
 
 namespace logger {
+    // A formatted line handed to a sink together with the level and time it was logged at
+    struct SinkMessage {
+        std::string_view text;
+        LogLevel level;
+        std::chrono::system_clock::time_point timestamp{};
+    };
+
+    // Sinks are shared between logging threads without an outer lock: write(), write_batch() and flush() may be
+    // called concurrently and is_valid() is called on every message, so it should be a cheap lock-free check
     class ILogSink {
     public:
         virtual ~ILogSink() = default;
         virtual void write(std::string_view message) = 0;
         virtual bool is_valid() const = 0;
+
+        // Lets a sink hand many lines to the OS at once; the default falls back to one write() per message
+        virtual void write_batch(const std::vector<SinkMessage> &messages) {
+            for (const auto &message: messages) {
+                write(message.text);
+            }
+        }
+
+        // Pushes any data the sink buffers internally to its destination
+        virtual void flush() {}
     };
 } // namespace logger
@@ -0,0 +1,104 @@
+#include "socket_endpoint.hpp"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/un.h>
+
+namespace logger {
+    namespace {
+        constexpr std::string_view UNIX_PREFIX = "unix:";
+        constexpr std::string_view SEQPACKET_PREFIX = "seqpacket:";
+        constexpr std::string_view UDP_PREFIX = "udp:";
+
+        bool starts_with(std::string_view value, std::string_view prefix) {
+            return value.size() >= prefix.size() && value.compare(0, prefix.size(), prefix) == 0;
+        }
+    } // namespace
+
+    SocketEndpoint SocketEndpoint::parse(std::string_view address, int port) {
+        SocketEndpoint endpoint;
+
+        if (starts_with(address, UNIX_PREFIX)) {
+            endpoint.transport = Transport::UNIX_STREAM;
+            endpoint.address = std::string(address.substr(UNIX_PREFIX.size()));
+        } else if (starts_with(address, SEQPACKET_PREFIX)) {
+            endpoint.transport = Transport::UNIX_SEQPACKET;
+            endpoint.address = std::string(address.substr(SEQPACKET_PREFIX.size()));
+        } else if (starts_with(address, UDP_PREFIX)) {
+            endpoint.transport = Transport::UDP;
+            endpoint.address = std::string(address.substr(UDP_PREFIX.size()));
+            endpoint.port = port;
+        } else {
+            endpoint.address = std::string(address);
+            endpoint.port = port;
+        }
+
+        return endpoint;
+    }
+
+    bool SocketEndpoint::is_unix_address(std::string_view address) {
+        return starts_with(address, UNIX_PREFIX) || starts_with(address, SEQPACKET_PREFIX);
+    }
+
+    bool SocketEndpoint::is_unix() const {
+        return transport == Transport::UNIX_STREAM || transport == Transport::UNIX_SEQPACKET;
+    }
+
+    bool SocketEndpoint::is_udp() const { return transport == Transport::UDP; }
+
+    int SocketEndpoint::socket_type() const {
+        switch (transport) {
+            case Transport::UNIX_SEQPACKET:
+                return SOCK_SEQPACKET;
+            case Transport::UDP:
+                return SOCK_DGRAM;
+            case Transport::TCP:
+            case Transport::UNIX_STREAM:
+            default:
+                return SOCK_STREAM;
+        }
+    }
+
+    int SocketEndpoint::address_family() const { return is_unix() ? AF_UNIX : AF_INET; }
+
+    bool SocketEndpoint::to_sockaddr(sockaddr_storage &storage, socklen_t &length) const {
+        memset(&storage, 0, sizeof(storage));
+
+        if (is_unix()) {
+            auto *addr = reinterpret_cast<sockaddr_un *>(&storage);
+            if (address.empty() || address.size() >= sizeof(addr->sun_path)) {
+                return false;
+            }
+
+            addr->sun_family = AF_UNIX;
+            memcpy(addr->sun_path, address.data(), address.size());
+            length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + address.size() + 1);
+            return true;
+        }
+
+        auto *addr = reinterpret_cast<sockaddr_in *>(&storage);
+        addr->sin_family = AF_INET;
+        addr->sin_port = htons(port);
+        if (inet_pton(AF_INET, address.c_str(), &addr->sin_addr) <= 0) {
+            return false;
+        }
+
+        length = sizeof(sockaddr_in);
+        return true;
+    }
+
+    std::string SocketEndpoint::to_string() const {
+        switch (transport) {
+            case Transport::UNIX_STREAM:
+                return std::string(UNIX_PREFIX) + address;
+            case Transport::UNIX_SEQPACKET:
+                return std::string(SEQPACKET_PREFIX) + address;
+            case Transport::UDP:
+                return std::string(UDP_PREFIX) + address + ":" + std::to_string(port);
+            case Transport::TCP:
+            default:
+                return address + ":" + std::to_string(port);
+        }
+    }
+} // namespace logger
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <sys/socket.h>
+
+namespace logger {
+    // Where a SocketSink connects to or a collector listens on. Besides TCP ("<ipv4 address>" plus a port),
+    // local Unix domain sockets are addressed as "unix:<path>" (byte stream) or "seqpacket:<path>"
+    // (SOCK_SEQPACKET, every send arrives as one record), and UDP as "udp:<ipv4 address>" plus a port.
+    struct SocketEndpoint {
+        enum class Transport { TCP, UNIX_STREAM, UNIX_SEQPACKET, UDP };
+
+        // Largest record sent over a SOCK_SEQPACKET socket; receivers must read with a buffer at least this large
+        static constexpr size_t MAX_SEQPACKET_SIZE = 64 * 1024;
+
+        Transport transport = Transport::TCP;
+        // IPv4 address for TCP, filesystem path otherwise
+        std::string address;
+        int port = 0;
+
+        // Recognizes the "unix:", "seqpacket:" and "udp:" prefixes; any other address is taken as TCP with the
+        // given port
+        [[nodiscard]] static SocketEndpoint parse(std::string_view address, int port = 0);
+        [[nodiscard]] static bool is_unix_address(std::string_view address);
+
+        [[nodiscard]] bool is_unix() const;
+        [[nodiscard]] bool is_udp() const;
+        [[nodiscard]] int socket_type() const;
+        [[nodiscard]] int address_family() const;
+        // Fills a sockaddr_in or sockaddr_un; returns false if the address is malformed
+        bool to_sockaddr(sockaddr_storage &storage, socklen_t &length) const;
+        [[nodiscard]] std::string to_string() const;
+    };
+} // namespace logger
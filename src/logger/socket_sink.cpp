@@ -1,128 +1,526 @@
 #include "socket_sink.hpp"
 
+#include <algorithm>
+#include <array>
 #include <arpa/inet.h>
 #include <cstring>
 #include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <iostream>
 #include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "protocol.hpp"
+
 namespace logger {
-    SocketSink::SocketSink(const std::string &host, int port) :
-        socket_fd_(-1), host_(host), port_(port), is_connected_(false) {
-        init_socket();
-        connect_to_server();
+    SocketSink::SocketSink(const std::string &host, int port, const SocketSinkOptions &options) :
+        SocketSink(SocketEndpoint::parse(host, port), options) {}
+
+    SocketSink::SocketSink(const SocketEndpoint &endpoint, const SocketSinkOptions &options) :
+        socket_fd_(-1), endpoint_(endpoint), options_(options) {
+        if (endpoint_.is_udp()) {
+            std::cerr << "[SocketSink] " << endpoint_.to_string() << " is a UDP endpoint, use UdpSink" << std::endl;
+            return;
+        }
+
+        if (options_.reconnect && not options_.spool_path.empty()) {
+            spool_ = std::make_unique<DiskSpool>(options_.spool_path, options_.max_spool_bytes);
+            if (not spool_->is_valid()) {
+                spool_.reset();
+            }
+        }
+
+        socket_fd_ = create_connection();
+        if (socket_fd_ == -1) {
+            return;
+        }
+
+        configure_socket();
+        is_connected_.store(true, std::memory_order_release);
+        healthy_.store(true, std::memory_order_release);
+
+        if (options_.reconnect || options_.coalesce) {
+            background_thread_ = std::thread(&SocketSink::background_thread_function, this);
+        }
     }
 
-    SocketSink::~SocketSink() { cleanup_socket(); }
+    SocketSink::~SocketSink() {
+        {
+            std::lock_guard<std::mutex> lock(socket_mutex_);
+            stopping_ = true;
+            background_condition_.notify_all();
+        }
+
+        if (background_thread_.joinable()) {
+            background_thread_.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(socket_mutex_);
+            if (is_connected_.load()) {
+                flush_send_buffer();
+            }
+
+            // Keep whatever is still buffered for the next run
+            if (spool_) {
+                move_spill_to_spool();
+            }
+        }
+
+        cleanup_socket();
+    }
 
     void SocketSink::write(std::string_view message) {
-        if (not is_valid()) {
+        write_batch({SinkMessage{message, LogLevel::INFO, std::chrono::system_clock::now()}});
+    }
+
+    void SocketSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid() || messages.empty()) {
             return;
         }
 
+        // An oversized frame would make the receiver drop the connection and then be replayed after every
+        // reconnect, so its payload is cut to the limit first
+        for (const auto &message: messages) {
+            if (message.text.size() > protocol::MAX_PAYLOAD_SIZE) {
+                std::vector<SinkMessage> truncated(messages);
+                for (auto &each: truncated) {
+                    if (each.text.size() > protocol::MAX_PAYLOAD_SIZE) {
+                        each.text = each.text.substr(0, protocol::MAX_PAYLOAD_SIZE);
+                        truncated_count_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                write_batch(truncated);
+                return;
+            }
+        }
+
+        if (options_.coalesce) {
+            coalesce(messages);
+            return;
+        }
+
+        // Every message becomes a header and a payload buffer
+        thread_local std::vector<std::array<char, protocol::HEADER_SIZE>> headers;
+        thread_local std::vector<iovec> iovecs;
+        headers.resize(messages.size());
+        iovecs.clear();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            const auto &message = messages[i];
+            protocol::encode_header(headers[i].data(), message.level, message.timestamp, message.text.size());
+            iovecs.push_back(iovec{headers[i].data(), protocol::HEADER_SIZE});
+            iovecs.push_back(iovec{const_cast<char *>(message.text.data()), message.text.size()});
+        }
+
         std::lock_guard<std::mutex> lock(socket_mutex_);
 
-        size_t total_sent = 0;
+        size_t sent = 0;
+        if (not must_queue()) {
+            sent = send_iovecs(iovecs.data(), iovecs.size());
+            if (sent == iovecs.size()) {
+                return;
+            }
+            handle_disconnect();
+        }
 
-        while (total_sent < message.size()) {
+        // A partially sent frame is resent whole on the next connection
+        for (size_t i = sent / 2; i < messages.size(); ++i) {
+            const auto &message = messages[i];
+            spill(protocol::encode_frame(message.text, message.level, message.timestamp));
+        }
+    }
+
+    void SocketSink::flush() {
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+        if (is_connected_.load()) {
+            flush_send_buffer();
+        }
+    }
+
+    bool SocketSink::is_valid() const { return healthy_.load(std::memory_order_acquire); }
+
+    bool SocketSink::is_connected() const { return is_connected_.load(std::memory_order_acquire); }
+
+    size_t SocketSink::dropped_count() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+    size_t SocketSink::truncated_count() const { return truncated_count_.load(std::memory_order_relaxed); }
+
+    size_t SocketSink::spooled_bytes() const {
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+        return spool_ ? spool_->size_bytes() : 0;
+    }
+
+    int SocketSink::create_connection() {
+        int fd = socket(endpoint_.address_family(), endpoint_.socket_type(), 0);
+
+        if (fd == -1) {
+            std::cerr << "[SocketSink] Failed to create socket: " << strerror(errno) << std::endl;
+            return -1;
+        }
+
+        if (not set_non_blocking(fd)) {
+            std::cerr << "[SocketSink] Failed to set socket non-blocking" << std::endl;
+            close(fd);
+            return -1;
+        }
+
+        sockaddr_storage server_addr;
+        socklen_t server_addr_len;
+
+        if (not endpoint_.to_sockaddr(server_addr, server_addr_len)) {
+            std::cerr << "[SocketSink] Invalid address format: " << endpoint_.address << std::endl;
+            close(fd);
+            return -1;
+        }
+
+        int result = connect(fd, (sockaddr *) &server_addr, server_addr_len);
+
+        if (result == 0) {
+            return fd;
+        }
+
+        if (errno == EINPROGRESS) {
+            if (wait_for_socket_ready(fd, true)) {
+                int error;
+                socklen_t len = sizeof(error);
+                if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0) {
+                    return fd;
+                } else {
+                    std::cerr << "[SocketSink] Connection failed: " << strerror(error) << std::endl;
+                }
+            } else {
+                std::cerr << "[SocketSink] Connection timeout" << std::endl;
+            }
+        } else {
+            std::cerr << "[SocketSink] Connect failed: " << strerror(errno) << std::endl;
+        }
+
+        close(fd);
+        return -1;
+    }
+
+    void SocketSink::cleanup_socket() {
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+
+        is_connected_ = false;
+        healthy_ = false;
+
+        if (socket_fd_ != -1) {
+            close(socket_fd_);
+            socket_fd_ = -1;
+        }
+    }
+
+    size_t SocketSink::send_iovecs(iovec *iovecs, size_t count) {
+        size_t index = 0;
+
+        while (index < count && iovecs[index].iov_len == 0) {
+            ++index;
+        }
+
+        while (index < count) {
             if (not wait_for_socket_ready(socket_fd_, true)) {
                 std::cerr << "[SocketSink] Socket not ready for writing, marking as disconnected" << std::endl;
-                is_connected_ = false;
-                return;
+                return index;
+            }
+
+            msghdr msg{};
+            msg.msg_iov = iovecs + index;
+            msg.msg_iovlen = std::min(count - index, MAX_IOVECS_PER_SEND);
+
+            // A SOCK_SEQPACKET record has to fit into the receiver's buffer; a buffer is only split across
+            // records when it is larger than that on its own
+            if (endpoint_.transport == SocketEndpoint::Transport::UNIX_SEQPACKET) {
+                size_t record_size = iovecs[index].iov_len;
+                size_t record_iovecs = 1;
+                while (record_iovecs < msg.msg_iovlen &&
+                       record_size + iovecs[index + record_iovecs].iov_len <= SocketEndpoint::MAX_SEQPACKET_SIZE) {
+                    record_size += iovecs[index + record_iovecs].iov_len;
+                    ++record_iovecs;
+                }
+                msg.msg_iovlen = record_iovecs;
             }
 
-            ssize_t sent = send(socket_fd_, message.data() + total_sent, message.size() - total_sent, MSG_NOSIGNAL);
+            // More chunks follow right away: let the kernel fill segments across the sendmsg() calls
+            int flags = MSG_NOSIGNAL;
+            if (not endpoint_.is_unix() && count - index > msg.msg_iovlen) {
+                flags |= MSG_MORE;
+            }
+
+            ssize_t sent = sendmsg(socket_fd_, &msg, flags);
 
             if (sent == -1) {
                 if (errno == EAGAIN || errno == EWOULDBLOCK) {
                     continue;
                 }
                 std::cerr << "[SocketSink] Send failed: " << strerror(errno) << std::endl;
-                is_connected_ = false;
-                return;
+                return index;
             }
 
-            total_sent += sent;
+            // Skip fully sent buffers and trim a partially sent one
+            size_t remaining = static_cast<size_t>(sent);
+            while (index < count && remaining >= iovecs[index].iov_len) {
+                remaining -= iovecs[index].iov_len;
+                ++index;
+            }
+            if (index < count && remaining > 0) {
+                iovecs[index].iov_base = static_cast<char *>(iovecs[index].iov_base) + remaining;
+                iovecs[index].iov_len -= remaining;
+            }
+        }
+
+        return count;
+    }
+
+    void SocketSink::handle_disconnect() {
+        is_connected_.store(false, std::memory_order_release);
+
+        // Frames still waiting for their deadline are older than anything written from now on, so they go to
+        // the spill now; flushed after the reconnect they would arrive behind the replayed ones
+        spill_send_buffer(0);
+
+        if (socket_fd_ != -1) {
+            close(socket_fd_);
+            socket_fd_ = -1;
+        }
+
+        if (options_.reconnect) {
+            background_condition_.notify_all();
+        } else {
+            healthy_.store(false, std::memory_order_release);
+        }
+    }
+
+    void SocketSink::configure_socket() {
+        // The send buffer already builds full segments, so Nagle would only add latency on top of the deadline
+        if (options_.coalesce && not endpoint_.is_unix()) {
+            int enable = 1;
+            setsockopt(socket_fd_, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
         }
     }
 
-    bool SocketSink::is_valid() const {
+    void SocketSink::coalesce(const std::vector<SinkMessage> &messages) {
         std::lock_guard<std::mutex> lock(socket_mutex_);
-        return socket_fd_ != -1 && is_connected_;
+
+        if (must_queue()) {
+            for (const auto &message: messages) {
+                spill(protocol::encode_frame(message.text, message.level, message.timestamp));
+            }
+            return;
+        }
+
+        bool was_empty = send_buffer_.empty();
+        bool urgent = false;
+
+        for (const auto &message: messages) {
+            size_t offset = send_buffer_.size();
+            send_buffer_.resize(offset + protocol::HEADER_SIZE + message.text.size());
+            protocol::encode_header(send_buffer_.data() + offset, message.level, message.timestamp,
+                                    message.text.size());
+            std::memcpy(send_buffer_.data() + offset + protocol::HEADER_SIZE, message.text.data(),
+                        message.text.size());
+            frame_sizes_.push_back(protocol::HEADER_SIZE + message.text.size());
+            urgent = urgent || message.level >= options_.coalesce_flush_level;
+        }
+
+        if (urgent || send_buffer_.size() >= options_.coalesce_bytes) {
+            flush_send_buffer();
+        } else if (was_empty) {
+            send_deadline_ = std::chrono::steady_clock::now() + options_.coalesce_delay;
+            background_condition_.notify_all();
+        }
     }
 
-    bool SocketSink::init_socket() {
-        socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    bool SocketSink::flush_send_buffer() {
+        if (send_buffer_.empty()) {
+            return true;
+        }
 
-        if (socket_fd_ == -1) {
-            std::cerr << "[SocketSink] Failed to create socket: " << strerror(errno) << std::endl;
-            return false;
+        thread_local std::vector<iovec> iovecs;
+        iovecs.clear();
+        size_t offset = 0;
+        for (size_t size: frame_sizes_) {
+            iovecs.push_back(iovec{send_buffer_.data() + offset, size});
+            offset += size;
         }
 
-        if (not set_non_blocking(socket_fd_)) {
-            std::cerr << "[SocketSink] Failed to set socket non-blocking" << std::endl;
-            close(socket_fd_);
-            socket_fd_ = -1;
+        size_t sent = send_iovecs(iovecs.data(), iovecs.size());
+        if (sent < iovecs.size()) {
+            spill_send_buffer(sent);
+            handle_disconnect();
             return false;
         }
 
+        send_buffer_.clear();
+        frame_sizes_.clear();
         return true;
     }
 
-    void SocketSink::cleanup_socket() {
-        std::lock_guard<std::mutex> lock(socket_mutex_);
+    void SocketSink::spill_send_buffer(size_t sent_frames) {
+        size_t offset = 0;
+        for (size_t i = 0; i < frame_sizes_.size(); ++i) {
+            if (i >= sent_frames) {
+                spill(send_buffer_.substr(offset, frame_sizes_[i]));
+            }
+            offset += frame_sizes_[i];
+        }
 
-        if (socket_fd_ != -1) {
-            close(socket_fd_);
-            socket_fd_ = -1;
+        send_buffer_.clear();
+        frame_sizes_.clear();
+    }
+
+    bool SocketSink::must_queue() const {
+        // While the spool is being drained new messages queue up behind it to keep their order
+        return not is_connected_.load(std::memory_order_relaxed) || (spool_ && not spool_->empty());
+    }
+
+    void SocketSink::spill(std::string frame) {
+        if (spool_ && (not spool_->empty() || spill_bytes_ + frame.size() > options_.max_spill_bytes)) {
+            move_spill_to_spool();
+            if (not spool_->append(frame)) {
+                dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return;
         }
 
-        is_connected_ = false;
+        if (frame.size() > options_.max_spill_bytes) {
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        while (not spill_.empty() && spill_bytes_ + frame.size() > options_.max_spill_bytes) {
+            spill_bytes_ -= spill_.front().size();
+            spill_.pop_front();
+            dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        spill_bytes_ += frame.size();
+        spill_.push_back(std::move(frame));
     }
 
-    bool SocketSink::connect_to_server() {
-        if (socket_fd_ == -1) {
-            std::cerr << "[SocketSink] Cannot connect - invalid socket" << std::endl;
-            return false;
+    void SocketSink::move_spill_to_spool() {
+        for (const auto &message: spill_) {
+            if (not spool_->append(message)) {
+                dropped_count_.fetch_add(1, std::memory_order_relaxed);
+            }
         }
 
-        sockaddr_in server_addr;
-        memset(&server_addr, 0, sizeof(server_addr));
-        server_addr.sin_family = AF_INET;
-        server_addr.sin_port = htons(port_);
+        spill_.clear();
+        spill_bytes_ = 0;
+    }
+
+    bool SocketSink::replay_spill() {
+        if (spill_.empty()) {
+            return true;
+        }
 
-        if (inet_pton(AF_INET, host_.data(), &server_addr.sin_addr) <= 0) {
-            std::cerr << "[SocketSink] Invalid address format: " << host_ << std::endl;
+        std::vector<iovec> iovecs;
+        iovecs.reserve(spill_.size());
+        for (auto &message: spill_) {
+            iovecs.push_back(iovec{message.data(), message.size()});
+        }
+
+        size_t sent = send_iovecs(iovecs.data(), iovecs.size());
+        for (size_t i = 0; i < sent; ++i) {
+            spill_bytes_ -= spill_.front().size();
+            spill_.pop_front();
+        }
+
+        return sent == iovecs.size();
+    }
+
+    bool SocketSink::drain_spool() {
+        size_t count = spool_->peek(spool_batch_, SPOOL_READ_SIZE);
+        if (count == 0) {
             return false;
         }
 
-        int result = connect(socket_fd_, (sockaddr *) &server_addr, sizeof(server_addr));
+        std::vector<iovec> iovecs;
+        iovecs.reserve(count);
+        for (auto &record: spool_batch_) {
+            iovecs.push_back(iovec{record.data(), record.size()});
+        }
+
+        size_t sent = send_iovecs(iovecs.data(), iovecs.size());
+        spool_->consume(sent);
 
-        if (result == 0) {
-            is_connected_ = true;
-            return true;
+        if (sent < count) {
+            handle_disconnect();
         }
+        return sent > 0;
+    }
 
-        if (errno == EINPROGRESS) {
-            if (wait_for_socket_ready(socket_fd_, true)) {
-                int error;
-                socklen_t len = sizeof(error);
-                if (getsockopt(socket_fd_, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0) {
-                    is_connected_ = true;
-                    return true;
+    void SocketSink::background_thread_function() {
+        std::unique_lock<std::mutex> lock(socket_mutex_);
+        auto backoff = options_.initial_backoff;
+
+        while (not stopping_) {
+            if (not is_connected_.load()) {
+                if (not options_.reconnect) {
+                    background_condition_.wait(lock, [this] { return stopping_; });
+                    continue;
+                }
+
+                // Connecting may take up to POLL_TIMEOUT_MS, writers keep spilling meanwhile
+                lock.unlock();
+                int fd = create_connection();
+                lock.lock();
+
+                if (stopping_) {
+                    if (fd != -1) {
+                        close(fd);
+                    }
+                    break;
+                }
+
+                if (fd == -1) {
+                    background_condition_.wait_for(lock, backoff, [this] { return stopping_; });
+                    backoff = std::min(backoff * 2, options_.max_backoff);
+                    continue;
+                }
+
+                socket_fd_ = fd;
+                configure_socket();
+                is_connected_.store(true, std::memory_order_release);
+                backoff = options_.initial_backoff;
+
+                // Replayed while holding socket_mutex_, so new messages cannot overtake the buffered ones
+                if (not replay_spill()) {
+                    handle_disconnect();
+                }
+                continue;
+            }
+
+            if (spool_ && not spool_->empty()) {
+                // Drained in large batches; writers only wait for one batch at a time
+                if (not drain_spool() && is_connected_.load()) {
+                    background_condition_.wait_for(lock, options_.initial_backoff, [this] { return stopping_; });
                 } else {
-                    std::cerr << "[SocketSink] Connection failed: " << strerror(error) << std::endl;
+                    lock.unlock();
+                    std::this_thread::yield();
+                    lock.lock();
                 }
-            } else {
-                std::cerr << "[SocketSink] Connection timeout" << std::endl;
+                continue;
+            }
+
+            if (not send_buffer_.empty()) {
+                // Give more messages until the deadline to join the buffer, unless a writer flushed it meanwhile
+                bool flushed = background_condition_.wait_until(lock, send_deadline_, [this] {
+                    return stopping_ || send_buffer_.empty() || not is_connected_.load();
+                });
+                if (not flushed) {
+                    flush_send_buffer();
+                }
+                continue;
             }
-        } else {
-            std::cerr << "[SocketSink] Connect failed: " << strerror(errno) << std::endl;
-        }
 
-        return false;
+            background_condition_.wait(lock, [this] {
+                return stopping_ || not is_connected_.load() || (spool_ && not spool_->empty()) ||
+                       not send_buffer_.empty();
+            });
+        }
     }
 
     bool SocketSink::set_non_blocking(int socket) {
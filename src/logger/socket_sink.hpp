@@ -1,33 +1,127 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
+#include <sys/uio.h>
+
+#include "disk_spool.hpp"
 #include "sink.hpp"
+#include "socket_endpoint.hpp"
 
 namespace logger {
+    struct SocketSinkOptions {
+        static constexpr size_t DEFAULT_MAX_SPILL_BYTES = 4 * 1024 * 1024;
+
+        // Reconnect in the background after the connection is lost instead of giving up for good
+        bool reconnect = true;
+        std::chrono::milliseconds initial_backoff{100};
+        std::chrono::milliseconds max_backoff{30000};
+        // Messages written while disconnected are kept up to this many bytes and replayed once reconnected;
+        // beyond that the oldest ones are dropped
+        size_t max_spill_bytes = DEFAULT_MAX_SPILL_BYTES;
+
+        // When set (and reconnect is on), messages that do not fit into the memory buffer go to a DiskSpool at
+        // this path. It is drained before any new message once the connection is back, and a spool left by a
+        // previous run is sent after the first successful connection.
+        std::string spool_path;
+        size_t max_spool_bytes = DiskSpool::DEFAULT_MAX_BYTES;
+
+        // Coalescing: frames are collected in a send buffer that goes out in one sendmsg() once it holds
+        // coalesce_bytes, once coalesce_delay has passed since its first frame, or right away for a message at
+        // coalesce_flush_level or above
+        bool coalesce = false;
+        size_t coalesce_bytes = 64 * 1024;
+        std::chrono::microseconds coalesce_delay{1000};
+        LogLevel coalesce_flush_level = LogLevel::ERROR;
+    };
+
+    // Sends every message as one length-prefixed frame of the wire protocol in protocol.hpp
     class SocketSink : public ILogSink {
     public:
-        explicit SocketSink(const std::string &host, int port);
+        // `host` may also be a "unix:<path>" or "seqpacket:<path>" address, the port is ignored then
+        SocketSink(const std::string &host, int port, const SocketSinkOptions &options = SocketSinkOptions());
+        explicit SocketSink(const SocketEndpoint &endpoint, const SocketSinkOptions &options = SocketSinkOptions());
         ~SocketSink() override;
 
         void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        // Sends the coalescing buffer right away
+        void flush() override;
+        // Stays true while a lost connection is being re-established, as messages are still accepted then
         bool is_valid() const override;
 
+        [[nodiscard]] bool is_connected() const;
+        // Messages discarded because the spill buffer overflowed or the spool rejected them during an outage
+        [[nodiscard]] size_t dropped_count() const;
+        // Messages cut to protocol::MAX_PAYLOAD_SIZE, which the receiver would reject as corrupt
+        [[nodiscard]] size_t truncated_count() const;
+        // Bytes waiting in the disk spool
+        [[nodiscard]] size_t spooled_bytes() const;
+
     private:
         static constexpr int POLL_TIMEOUT_MS = 1000;
+        static constexpr size_t MAX_IOVECS_PER_SEND = 1024;
+        static constexpr size_t SPOOL_READ_SIZE = 1024 * 1024;
 
-        bool init_socket();
+        // Returns a connected non-blocking socket or -1
+        int create_connection();
+        // Applies per-connection socket options; expects socket_mutex_ to be held
+        void configure_socket();
         void cleanup_socket();
-        bool connect_to_server();
         bool set_non_blocking(int socket);
         bool wait_for_socket_ready(int socket, bool for_write = true);
+        // Sends all buffers with as few sendmsg() calls as possible and returns the index of the first buffer that
+        // was not sent completely (count on success); expects socket_mutex_ to be held
+        size_t send_iovecs(iovec *iovecs, size_t count);
+        // Appends the messages to the send buffer and flushes it if a threshold is reached
+        void coalesce(const std::vector<SinkMessage> &messages);
+
+        // The following expect socket_mutex_ to be held
+        void handle_disconnect();
+        bool flush_send_buffer();
+        // Moves the frames of the send buffer from `sent_frames` on to the spill and empties it
+        void spill_send_buffer(size_t sent_frames);
+        bool must_queue() const;
+        void spill(std::string frame);
+        void move_spill_to_spool();
+        bool replay_spill();
+        // Sends one batch of spooled records; returns false if nothing could be sent
+        bool drain_spool();
+
+        // Reconnects, drains the spool and flushes the coalescing buffer on its deadline
+        void background_thread_function();
 
     private:
         int socket_fd_;
         mutable std::mutex socket_mutex_;
-        std::string host_;
-        int port_;
-        bool is_connected_;
+        SocketEndpoint endpoint_;
+        SocketSinkOptions options_;
+
+        // Read without socket_mutex_ on every log call
+        std::atomic<bool> is_connected_{false};
+        std::atomic<bool> healthy_{false};
+
+        // Outage handling; both buffers hold encoded frames
+        std::deque<std::string> spill_;
+        size_t spill_bytes_ = 0;
+        std::atomic<size_t> dropped_count_{0};
+        std::atomic<size_t> truncated_count_{0};
+        std::unique_ptr<DiskSpool> spool_;
+        std::vector<std::string> spool_batch_;
+
+        // Coalescing buffer: encoded frames back to back
+        std::string send_buffer_;
+        std::vector<size_t> frame_sizes_;
+        std::chrono::steady_clock::time_point send_deadline_;
+        std::thread background_thread_;
+        std::condition_variable background_condition_;
+        bool stopping_ = false;
     };
 } // namespace logger
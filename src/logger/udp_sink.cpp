@@ -0,0 +1,171 @@
+#include "udp_sink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace logger {
+    namespace {
+        struct Datagram {
+            size_t offset;
+            size_t size;
+            size_t messages;
+        };
+
+        // Per-thread packing state, reused across calls so a batch costs no allocation once warmed up
+        thread_local std::string packet_buffer;
+        thread_local std::vector<Datagram> datagrams;
+        thread_local std::vector<iovec> datagram_iovecs;
+        thread_local std::vector<mmsghdr> datagram_headers;
+
+        // A bare IPv4 address means UDP here rather than TCP
+        SocketEndpoint udp_endpoint(const std::string &host, int port) {
+            SocketEndpoint endpoint = SocketEndpoint::parse(host, port);
+            if (endpoint.transport == SocketEndpoint::Transport::TCP) {
+                endpoint.transport = SocketEndpoint::Transport::UDP;
+            }
+            return endpoint;
+        }
+    } // namespace
+
+    UdpSink::UdpSink(const std::string &host, int port, const UdpSinkOptions &options) :
+        UdpSink(udp_endpoint(host, port), options) {}
+
+    UdpSink::UdpSink(const SocketEndpoint &endpoint, const UdpSinkOptions &options) :
+        socket_fd_(-1), endpoint_(endpoint), options_(options) {
+        if (not endpoint_.is_udp()) {
+            std::cerr << "[UdpSink] " << endpoint_.to_string() << " is not a UDP endpoint" << std::endl;
+            return;
+        }
+
+        sockaddr_storage address;
+        socklen_t address_length;
+        if (not endpoint_.to_sockaddr(address, address_length)) {
+            std::cerr << "[UdpSink] Invalid address: " << endpoint_.to_string() << std::endl;
+            return;
+        }
+
+        socket_fd_ = socket(endpoint_.address_family(), SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (socket_fd_ == -1) {
+            std::cerr << "[UdpSink] Failed to create socket: " << strerror(errno) << std::endl;
+            return;
+        }
+
+        // Fixes the destination, so plain sends work and the kernel skips the route lookup per datagram
+        if (connect(socket_fd_, reinterpret_cast<sockaddr *>(&address), address_length) == -1) {
+            std::cerr << "[UdpSink] Failed to connect to " << endpoint_.to_string() << ": " << strerror(errno)
+                      << std::endl;
+            close(socket_fd_);
+            socket_fd_ = -1;
+        }
+    }
+
+    UdpSink::~UdpSink() {
+        if (socket_fd_ != -1) {
+            close(socket_fd_);
+        }
+    }
+
+    void UdpSink::write(std::string_view message) {
+        write_batch({SinkMessage{message, LogLevel::INFO, std::chrono::system_clock::now()}});
+    }
+
+    void UdpSink::write_batch(const std::vector<SinkMessage> &messages) {
+        if (not is_valid() || messages.empty()) {
+            return;
+        }
+
+        uint32_t sequence = next_sequence_.fetch_add(static_cast<uint32_t>(messages.size()), std::memory_order_relaxed);
+        size_t budget = std::clamp(options_.max_datagram_size, protocol::DATAGRAM_HEADER_SIZE + protocol::HEADER_SIZE,
+                                   protocol::MAX_DATAGRAM_SIZE);
+
+        packet_buffer.clear();
+        datagrams.clear();
+        size_t dropped = 0;
+        bool open = false;
+
+        for (size_t i = 0; i < messages.size(); ++i) {
+            const auto &message = messages[i];
+            size_t frame_size = protocol::HEADER_SIZE + message.text.size();
+
+            if (protocol::DATAGRAM_HEADER_SIZE + frame_size > protocol::MAX_DATAGRAM_SIZE) {
+                // Its sequence number stays unused, so the receiver sees the gap; later frames need a new datagram
+                ++dropped;
+                open = false;
+                continue;
+            }
+
+            if (not open || datagrams.back().size + frame_size > budget) {
+                datagrams.push_back(Datagram{packet_buffer.size(), protocol::DATAGRAM_HEADER_SIZE, 0});
+                packet_buffer.resize(packet_buffer.size() + protocol::DATAGRAM_HEADER_SIZE);
+                protocol::encode_datagram_header(packet_buffer.data() + datagrams.back().offset,
+                                                 sequence + static_cast<uint32_t>(i));
+                open = true;
+            }
+
+            size_t offset = packet_buffer.size();
+            packet_buffer.resize(offset + frame_size);
+            protocol::encode_header(packet_buffer.data() + offset, message.level, message.timestamp,
+                                    message.text.size());
+            std::memcpy(packet_buffer.data() + offset + protocol::HEADER_SIZE, message.text.data(),
+                        message.text.size());
+
+            datagrams.back().size += frame_size;
+            ++datagrams.back().messages;
+        }
+
+        size_t sent = send_datagrams(datagrams.size());
+        for (size_t i = sent; i < datagrams.size(); ++i) {
+            dropped += datagrams[i].messages;
+        }
+
+        sent_datagrams_.fetch_add(sent, std::memory_order_relaxed);
+        if (dropped > 0) {
+            dropped_count_.fetch_add(dropped, std::memory_order_relaxed);
+        }
+    }
+
+    bool UdpSink::is_valid() const { return socket_fd_ != -1; }
+
+    size_t UdpSink::dropped_count() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+    size_t UdpSink::sent_datagrams() const { return sent_datagrams_.load(std::memory_order_relaxed); }
+
+    size_t UdpSink::send_datagrams(size_t count) {
+        datagram_iovecs.resize(count);
+        datagram_headers.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            datagram_iovecs[i].iov_base = packet_buffer.data() + datagrams[i].offset;
+            datagram_iovecs[i].iov_len = datagrams[i].size;
+
+            datagram_headers[i] = mmsghdr{};
+            datagram_headers[i].msg_hdr.msg_iov = &datagram_iovecs[i];
+            datagram_headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        size_t sent = 0;
+        bool retried = false;
+
+        while (sent < count) {
+            auto batch = static_cast<unsigned int>(std::min(count - sent, MAX_DATAGRAMS_PER_SEND));
+            int result = sendmmsg(socket_fd_, datagram_headers.data() + sent, batch, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+            if (result == -1) {
+                // ECONNREFUSED reports an ICMP error caused by an earlier datagram, this one was not sent yet
+                if (errno == EINTR || (errno == ECONNREFUSED && not retried)) {
+                    retried = true;
+                    continue;
+                }
+                break; // EAGAIN included: never wait for buffer space
+            }
+
+            sent += static_cast<size_t>(result);
+        }
+
+        return sent;
+    }
+} // namespace logger
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "protocol.hpp"
+#include "sink.hpp"
+#include "socket_endpoint.hpp"
+
+namespace logger {
+    struct UdpSinkOptions {
+        // 1500-byte Ethernet MTU minus the IPv4 and UDP headers, so datagrams are never fragmented
+        static constexpr size_t DEFAULT_MAX_DATAGRAM_SIZE = 1472;
+
+        // Frames of one batch are packed into datagrams of at most this many bytes. A frame that does not fit
+        // into an empty datagram is sent alone (and fragmented by IP) as long as it fits into a UDP datagram.
+        size_t max_datagram_size = DEFAULT_MAX_DATAGRAM_SIZE;
+    };
+
+    // Fire-and-forget sink: frames of the wire protocol travel in UDP datagrams sent with MSG_DONTWAIT, so a
+    // log call never waits on the network. Whatever the kernel does not accept right away is dropped and
+    // counted; every datagram carries the sequence number of its first message, which lets the receiver count
+    // losses on the way as well. No state is kept between calls and no background thread is started.
+    class UdpSink : public ILogSink {
+    public:
+        // `host` is an IPv4 address with or without the "udp:" prefix
+        UdpSink(const std::string &host, int port, const UdpSinkOptions &options = UdpSinkOptions());
+        explicit UdpSink(const SocketEndpoint &endpoint, const UdpSinkOptions &options = UdpSinkOptions());
+        ~UdpSink() override;
+
+        void write(std::string_view message) override;
+        void write_batch(const std::vector<SinkMessage> &messages) override;
+        bool is_valid() const override;
+
+        // Messages the kernel did not accept, e.g. because the socket buffer was full
+        [[nodiscard]] size_t dropped_count() const;
+        [[nodiscard]] size_t sent_datagrams() const;
+
+    private:
+        static constexpr size_t MAX_DATAGRAMS_PER_SEND = 64;
+
+        // Sends the datagrams with as few sendmmsg() calls as possible; returns how many went out
+        size_t send_datagrams(size_t count);
+
+    private:
+        int socket_fd_;
+        SocketEndpoint endpoint_;
+        UdpSinkOptions options_;
+
+        // Message sequence numbers are reserved per batch, so concurrent callers never share a range
+        std::atomic<uint32_t> next_sequence_{0};
+        std::atomic<size_t> dropped_count_{0};
+        std::atomic<size_t> sent_datagrams_{0};
+    };
+} // namespace logger
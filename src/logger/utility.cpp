@@ -1,39 +1,144 @@
 #include "utility.hpp"
 
 #include <algorithm>
-#include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <ctime>
+#include <string>
 
 namespace logger {
     namespace utility {
+        namespace {
+            // "[DEBUG] ", "[INFO] ", ... built once at compile time
+            template<size_t N>
+            struct LevelPrefix {
+                std::array<char, N> data{};
+                size_t size = 0;
+            };
+
+            constexpr size_t LEVEL_PREFIX_CAPACITY = 16;
+
+            constexpr LevelPrefix<LEVEL_PREFIX_CAPACITY> make_level_prefix(logger::LogLevel level) {
+                LevelPrefix<LEVEL_PREFIX_CAPACITY> prefix;
+                std::string_view name = level_to_string_view(level);
+
+                prefix.data[prefix.size++] = '[';
+                for (char c: name) {
+                    prefix.data[prefix.size++] = c;
+                }
+                prefix.data[prefix.size++] = ']';
+                prefix.data[prefix.size++] = ' ';
+                return prefix;
+            }
+
+            constexpr std::array<LevelPrefix<LEVEL_PREFIX_CAPACITY>, 6> LEVEL_PREFIXES = {
+                    make_level_prefix(logger::LogLevel::DEBUG),   make_level_prefix(logger::LogLevel::INFO),
+                    make_level_prefix(logger::LogLevel::WARNING), make_level_prefix(logger::LogLevel::ERROR),
+                    make_level_prefix(logger::LogLevel::FATAL),   make_level_prefix(static_cast<logger::LogLevel>(5)),
+            };
+
+            std::string_view level_prefix(logger::LogLevel level) {
+                size_t index = static_cast<size_t>(level);
+                const auto &prefix = index < LEVEL_PREFIXES.size() - 1 ? LEVEL_PREFIXES[index] : LEVEL_PREFIXES.back();
+                return std::string_view(prefix.data.data(), prefix.size);
+            }
+
+            // Writes value as exactly `width` decimal digits, zero-padded on the left
+            void write_digits(char *buffer, unsigned long value, size_t width) {
+                for (size_t i = width; i > 0; --i) {
+                    buffer[i - 1] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                }
+            }
+
+            // "[" + timestamp + "] " + "[LEVEL] "
+            constexpr size_t HEADER_RESERVE = TIMESTAMP_LENGTH + 3 + LEVEL_PREFIX_CAPACITY;
+
+            // "YYYY-MM-DD HH:MM:SS."
+            constexpr size_t TIMESTAMP_PREFIX_LENGTH = 20;
+
+            std::atomic<TimestampPrecision> timestamp_precision{TimestampPrecision::MILLISECONDS};
+
+            struct TimestampCache {
+                std::time_t second = -1;
+                std::array<char, TIMESTAMP_PREFIX_LENGTH> prefix{};
+            };
+
+            void build_timestamp_prefix(TimestampCache &cache, std::time_t second) {
+                std::tm lt;
+                localtime_r(&second, &lt);
+
+                char *buffer = cache.prefix.data();
+                write_digits(buffer, lt.tm_year + 1900, 4);
+                buffer[4] = '-';
+                write_digits(buffer + 5, lt.tm_mon + 1, 2);
+                buffer[7] = '-';
+                write_digits(buffer + 8, lt.tm_mday, 2);
+                buffer[10] = ' ';
+                write_digits(buffer + 11, lt.tm_hour, 2);
+                buffer[13] = ':';
+                write_digits(buffer + 14, lt.tm_min, 2);
+                buffer[16] = ':';
+                write_digits(buffer + 17, lt.tm_sec, 2);
+                buffer[19] = '.';
+
+                cache.second = second;
+            }
+        } // namespace
 
         std::string format_message(std::string_view message, logger::LogLevel level) {
-            std::ostringstream oss;
-            oss << "[" << utility::get_current_timestamp() << "] "
-                << "[" << utility::level_to_string(level) << "] " << message;
-            return oss.str();
+            return format_message(message, level, std::chrono::system_clock::now());
+        }
+
+        std::string format_message(std::string_view message, logger::LogLevel level,
+                                   std::chrono::system_clock::time_point timestamp) {
+            return std::string(format_message_view(message, level, timestamp));
         }
 
-        std::string level_to_string(logger::LogLevel level) {
-            using logger::LogLevel;
-
-            switch (level) {
-                case LogLevel::DEBUG:
-                    return "DEBUG";
-                case LogLevel::INFO:
-                    return "INFO";
-                case LogLevel::WARNING:
-                    return "WARNING";
-                case LogLevel::ERROR:
-                    return "ERROR";
-                case LogLevel::FATAL:
-                    return "FATAL";
-                default:
-                    return "UNKNOWN";
+        std::string_view format_message_to(char *buffer, size_t buffer_size, std::string_view message,
+                                           logger::LogLevel level, std::chrono::system_clock::time_point timestamp) {
+            std::string_view prefix = level_prefix(level);
+            size_t header_size = TIMESTAMP_LENGTH + 3 + prefix.size();
+
+            if (buffer_size < header_size) {
+                return {};
+            }
+
+            char *out = buffer;
+            *out++ = '[';
+            write_timestamp(out, timestamp);
+            out += TIMESTAMP_LENGTH;
+            *out++ = ']';
+            *out++ = ' ';
+            std::memcpy(out, prefix.data(), prefix.size());
+            out += prefix.size();
+
+            size_t message_size = std::min(message.size(), buffer_size - header_size);
+            std::memcpy(out, message.data(), message_size);
+            out += message_size;
+
+            return std::string_view(buffer, out - buffer);
+        }
+
+        std::string_view format_message_view(std::string_view message, logger::LogLevel level,
+                                             std::chrono::system_clock::time_point timestamp) {
+            thread_local std::array<char, FORMAT_BUFFER_SIZE> buffer;
+
+            size_t required = HEADER_RESERVE + message.size();
+            if (required <= buffer.size()) {
+                return format_message_to(buffer.data(), buffer.size(), message, level, timestamp);
+            }
+
+            thread_local std::string overflow_buffer;
+            if (overflow_buffer.size() < required) {
+                overflow_buffer.resize(required);
             }
+            return format_message_to(overflow_buffer.data(), overflow_buffer.size(), message, level, timestamp);
         }
 
+        std::string level_to_string(logger::LogLevel level) { return std::string(level_to_string_view(level)); }
+
         std::optional<logger::LogLevel> string_to_level(std::string level_str) {
             std::transform(level_str.begin(), level_str.end(), level_str.begin(), ::tolower);
 
@@ -51,19 +156,39 @@ namespace logger {
             return std::nullopt;
         }
 
-        std::string get_current_timestamp() {
-            auto now = std::chrono::system_clock::now();
-            auto ts = std::chrono::floor<std::chrono::seconds>(now);
-            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - ts).count();
+        std::string get_current_timestamp() { return format_timestamp(std::chrono::system_clock::now()); }
+
+        std::string format_timestamp(std::chrono::system_clock::time_point timestamp) {
+            std::string result(TIMESTAMP_LENGTH, '\0');
+            write_timestamp(result.data(), timestamp);
+            return result;
+        }
 
-            std::time_t t_c = std::chrono::system_clock::to_time_t(ts);
-            std::tm lt = *std::localtime(&t_c);
+        void write_timestamp(char *buffer, std::chrono::system_clock::time_point timestamp) {
+            thread_local TimestampCache cache;
+
+            auto ts = std::chrono::floor<std::chrono::seconds>(timestamp);
+            std::time_t second = std::chrono::system_clock::to_time_t(ts);
+            if (second != cache.second) {
+                build_timestamp_prefix(cache, second);
+            }
 
-            std::ostringstream oss;
-            oss << std::put_time(&lt, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(6) << std::setfill('0') << ms;
+            std::memcpy(buffer, cache.prefix.data(), TIMESTAMP_PREFIX_LENGTH);
 
-            return oss.str();
+            long sub_second;
+            if (timestamp_precision.load(std::memory_order_relaxed) == TimestampPrecision::MICROSECONDS) {
+                sub_second = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - ts).count();
+            } else {
+                sub_second = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp - ts).count();
+            }
+            write_digits(buffer + TIMESTAMP_PREFIX_LENGTH, sub_second, TIMESTAMP_LENGTH - TIMESTAMP_PREFIX_LENGTH);
+        }
+
+        void set_timestamp_precision(TimestampPrecision precision) {
+            timestamp_precision.store(precision, std::memory_order_relaxed);
         }
 
+        TimestampPrecision get_timestamp_precision() { return timestamp_precision.load(std::memory_order_relaxed); }
+
     } // namespace utility
 } // namespace logger
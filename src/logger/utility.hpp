@@ -1,6 +1,7 @@
 #pragma once
 
 // #include <string>
+#include <chrono>
 #include <string_view>
 
 #include "log_level.hpp"
@@ -9,12 +10,60 @@
 
 namespace logger {
     namespace utility {
+        // "YYYY-MM-DD HH:MM:SS.ffffff"
+        inline constexpr size_t TIMESTAMP_LENGTH = 26;
+        // Size of the thread-local buffer used by format_message_view
+        inline constexpr size_t FORMAT_BUFFER_SIZE = 4096;
+
+        // What the 6-digit sub-second field of a timestamp carries. MILLISECONDS keeps the historical
+        // zero-padded milliseconds ("...:05.000123" is 123 ms), MICROSECONDS stores real microseconds.
+        enum class TimestampPrecision { MILLISECONDS, MICROSECONDS };
+
         [[nodiscard]] std::string format_message(std::string_view message, logger::LogLevel level);
+        [[nodiscard]] std::string format_message(std::string_view message, logger::LogLevel level,
+                                                 std::chrono::system_clock::time_point timestamp);
+
+        // Writes "[timestamp] [LEVEL] message" into the caller-supplied buffer without allocating.
+        // The message is truncated if the buffer is too small.
+        [[nodiscard]] std::string_view format_message_to(char *buffer, size_t buffer_size, std::string_view message,
+                                                         logger::LogLevel level,
+                                                         std::chrono::system_clock::time_point timestamp);
+
+        // Same as format_message_to, but formats into a thread-local buffer. The returned view stays valid until
+        // the next call on the same thread. Only messages longer than FORMAT_BUFFER_SIZE allocate.
+        [[nodiscard]] std::string_view
+        format_message_view(std::string_view message, logger::LogLevel level,
+                            std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now());
+
+        [[nodiscard]] constexpr std::string_view level_to_string_view(logger::LogLevel level) {
+            switch (level) {
+                case logger::LogLevel::DEBUG:
+                    return "DEBUG";
+                case logger::LogLevel::INFO:
+                    return "INFO";
+                case logger::LogLevel::WARNING:
+                    return "WARNING";
+                case logger::LogLevel::ERROR:
+                    return "ERROR";
+                case logger::LogLevel::FATAL:
+                    return "FATAL";
+                default:
+                    return "UNKNOWN";
+            }
+        }
 
         [[nodiscard]] std::string level_to_string(logger::LogLevel level);
 
         [[nodiscard]] std::optional<logger::LogLevel> string_to_level(std::string level_str);
 
         [[nodiscard]] std::string get_current_timestamp();
+        [[nodiscard]] std::string format_timestamp(std::chrono::system_clock::time_point timestamp);
+
+        // Writes exactly TIMESTAMP_LENGTH characters into buffer. The "YYYY-MM-DD HH:MM:SS" part is cached per
+        // thread and only rebuilt when the second changes.
+        void write_timestamp(char *buffer, std::chrono::system_clock::time_point timestamp);
+
+        void set_timestamp_precision(TimestampPrecision precision);
+        [[nodiscard]] TimestampPrecision get_timestamp_precision();
     } // namespace utility
 } // namespace logger
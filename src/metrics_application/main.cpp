@@ -2,6 +2,8 @@
 #include <memory>
 
 #include <logger/logger.hpp>
+#include <logger/shm_ring.hpp>
+#include <logger/socket_endpoint.hpp>
 
 #include "metrics_application.hpp"
 #include "utility.hpp"
@@ -9,28 +11,37 @@
 int main(int argc, char *argv[]) {
     using namespace metrics_application;
 
-    if (argc != 5) {
+    // A Unix socket address ("unix:<path>" or "seqpacket:<path>") or a shared memory ring ("shm:<name>")
+    // takes the place of both host and port
+    bool is_local = argc > 1 && (logger::SocketEndpoint::is_unix_address(argv[1]) ||
+                                 logger::ShmRing::is_shm_address(argv[1]));
+    int expected_argc = is_local ? 4 : 5;
+
+    if (argc != expected_argc) {
         utility::print_usage(argv[0]);
         return 1;
     }
 
     std::string host = argv[1];
-    int port, message_interval, timeout_seconds;
+    int port = 0, message_interval, timeout_seconds;
+    int next_arg = 2;
 
     try {
-        port = std::stoi(argv[2]);
-        if (port <= 0 || port > 65535) {
-            std::cerr << "Error: Port must be between 1 and 65535" << std::endl;
-            return 1;
+        if (not is_local) {
+            port = std::stoi(argv[next_arg++]);
+            if (port <= 0 || port > 65535) {
+                std::cerr << "Error: Port must be between 1 and 65535" << std::endl;
+                return 1;
+            }
         }
 
-        message_interval = std::stoi(argv[3]);
+        message_interval = std::stoi(argv[next_arg++]);
         if (message_interval <= 0) {
             std::cerr << "Error: Message interval N must be positive" << std::endl;
             return 1;
         }
 
-        timeout_seconds = std::stoi(argv[4]);
+        timeout_seconds = std::stoi(argv[next_arg]);
         if (timeout_seconds <= 0) {
             std::cerr << "Error: Timeout T must be positive" << std::endl;
             return 1;
@@ -38,7 +38,7 @@ namespace metrics_application {
         }
     }
 
-    void MessageProcessor::process_message(std::string_view log_message) {
+    void MessageProcessor::process_message(std::string_view log_message, logger::LogLevel level) {
         std::cout << "[" << logger::utility::get_current_timestamp() << "] LOG: " << log_message << std::endl;
 
         auto message_opt = utility::parse_message_from_log(log_message);
@@ -47,13 +47,7 @@ namespace metrics_application {
             return;
         }
 
-        auto level_opt = utility::parse_level_from_log(log_message);
-        if (not level_opt.has_value()) {
-            std::cerr << "Error parsing level from log" << std::endl;
-            return;
-        }
-
-        metrics_collector_->add_message(message_opt.value(), level_opt.value());
+        metrics_collector_->add_message(message_opt.value(), level);
 
         // Reset timer when new message arrives
         last_stats_print_time_ = std::chrono::steady_clock::now();
@@ -69,6 +63,10 @@ namespace metrics_application {
         }
     }
 
+    void MessageProcessor::process_loss(uint64_t lost_messages) {
+        metrics_collector_->add_lost_messages(lost_messages);
+    }
+
     void MessageProcessor::set_stats_callback(StatsCallback callback) { stats_callback_ = callback; }
 
     void MessageProcessor::stats_timer_thread() {
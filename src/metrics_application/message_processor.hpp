@@ -1,9 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string_view>
+
+#include <logger/log_level.hpp>
 #include <thread>
 
 namespace metrics_application {
@@ -20,7 +23,8 @@ namespace metrics_application {
     public:
         void start();
         void stop();
-        void process_message(std::string_view log_message);
+        void process_message(std::string_view log_message, logger::LogLevel level);
+        void process_loss(uint64_t lost_messages);
 
         // Set callback for when stats should be printed
         void set_stats_callback(StatsCallback callback);
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include <logger/log_level.hpp>
+
+namespace metrics_application {
+    // Source of log messages for the metrics collector
+    class IMessageServer {
+    public:
+        using MessageCallback = std::function<void(std::string_view, logger::LogLevel)>;
+        // Messages known to be lost on the way since the previous report
+        using LossCallback = std::function<void(uint64_t)>;
+
+    public:
+        virtual ~IMessageServer() = default;
+
+        // Prepares the transport and waits for a logger if the transport needs one
+        virtual bool start() = 0;
+        // Delivers messages to the callback until stopped or the logger goes away (blocking)
+        virtual void run() = 0;
+        virtual void stop() = 0;
+
+        virtual void set_message_callback(MessageCallback callback) = 0;
+        virtual void set_loss_callback(LossCallback callback) = 0;
+    };
+} // namespace metrics_application
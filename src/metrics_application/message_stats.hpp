@@ -21,6 +21,9 @@ namespace metrics_application {
         size_t max_length = 0;
         double average_length = 0.0;
 
+        // Messages the transport reported as lost before reaching the collector (UDP, shared memory ring)
+        size_t lost_messages = 0;
+
     public:
         // For calculating average_length
         size_t total_length = 0;
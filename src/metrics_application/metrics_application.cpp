@@ -1,7 +1,12 @@
 #include "metrics_application.hpp"
 
 #include <iostream>
+
+#include <logger/shm_ring.hpp>
+#include <logger/socket_endpoint.hpp>
+
 #include "message_processor.hpp"
+#include "shm_server.hpp"
 #include "socket_server.hpp"
 
 namespace metrics_application {
@@ -9,11 +14,23 @@ namespace metrics_application {
                                                                                int message_interval,
                                                                                int timeout_seconds) {
 
-        auto socket_server = std::make_unique<SocketServer>(host, port);
+        bool is_shm = logger::ShmRing::is_shm_address(host);
+
+        std::unique_ptr<IMessageServer> message_server;
+        if (is_shm) {
+            message_server = std::make_unique<ShmServer>(host);
+        } else {
+            message_server = std::make_unique<SocketServer>(host, port);
+        }
         auto message_processor = std::make_unique<MessageProcessor>(message_interval, timeout_seconds);
 
-        if (not socket_server->start()) {
-            std::cerr << "Failed to start socket server on " << host << ":" << port << std::endl;
+        if (not message_server->start()) {
+            if (is_shm) {
+                std::cerr << "Failed to create shared memory ring " << logger::ShmRing::object_name(host) << std::endl;
+            } else {
+                std::cerr << "Failed to start socket server on "
+                          << logger::SocketEndpoint::parse(host, port).to_string() << std::endl;
+            }
             return nullptr;
         }
 
@@ -21,33 +38,37 @@ namespace metrics_application {
         std::cout << "or after " << timeout_seconds << " seconds of inactivity" << std::endl;
 
         return std::unique_ptr<MetricsApplication>(
-                new MetricsApplication(std::move(socket_server), std::move(message_processor)));
+                new MetricsApplication(std::move(message_server), std::move(message_processor)));
     }
 
-    MetricsApplication::MetricsApplication(std::unique_ptr<SocketServer> socket_server,
+    MetricsApplication::MetricsApplication(std::unique_ptr<IMessageServer> message_server,
                                            std::unique_ptr<MessageProcessor> message_processor) :
-        socket_server_(std::move(socket_server)), message_processor_(std::move(message_processor)), is_running_(false) {
-    }
+        message_server_(std::move(message_server)), message_processor_(std::move(message_processor)),
+        is_running_(false) {}
 
     MetricsApplication::~MetricsApplication() { stop(); }
 
     void MetricsApplication::run() {
-        if (not socket_server_ || not message_processor_) {
-            std::cerr << "Socket server or message processor not available" << std::endl;
+        if (not message_server_ || not message_processor_) {
+            std::cerr << "Message server or message processor not available" << std::endl;
             return;
         }
 
         is_running_ = true;
 
-        // Setup callback from socket server to message processor
-        socket_server_->set_message_callback(
-                [this](std::string_view message) { message_processor_->process_message(message); });
+        // Setup callback from message server to message processor
+        message_server_->set_message_callback(
+                [this](std::string_view message, logger::LogLevel level) {
+                    message_processor_->process_message(message, level);
+                });
+        message_server_->set_loss_callback(
+                [this](uint64_t lost_messages) { message_processor_->process_loss(lost_messages); });
 
         // Start message processor
         message_processor_->start();
 
-        // Run socket server (blocking)
-        socket_server_->run();
+        // Run message server (blocking)
+        message_server_->run();
     }
 
     void MetricsApplication::stop() {
@@ -58,8 +79,8 @@ namespace metrics_application {
                 message_processor_->stop();
             }
 
-            if (socket_server_) {
-                socket_server_->stop();
+            if (message_server_) {
+                message_server_->stop();
             }
         }
     }
@@ -4,11 +4,13 @@
 #include <string>
 
 namespace metrics_application {
-    class SocketServer;
+    class IMessageServer;
     class MessageProcessor;
 
     class MetricsApplication {
     public:
+        // `host` may be a TCP or "udp:" address, a Unix socket address (the port is ignored then) or "shm:<name>"
+        // to read from a shared memory ring
         [[nodiscard]] static std::unique_ptr<MetricsApplication>
         create_application(const std::string &host, int port, int message_interval, int timeout_seconds);
 
@@ -19,11 +21,11 @@ namespace metrics_application {
         void stop();
 
     private:
-        MetricsApplication(std::unique_ptr<SocketServer> socket_server,
+        MetricsApplication(std::unique_ptr<IMessageServer> message_server,
                            std::unique_ptr<MessageProcessor> message_processor);
 
     private:
-        std::unique_ptr<SocketServer> socket_server_;
+        std::unique_ptr<IMessageServer> message_server_;
         std::unique_ptr<MessageProcessor> message_processor_;
         bool is_running_;
     };
@@ -29,6 +29,11 @@ namespace metrics_application {
         stats_.message_timestamps.push_back(now);
     }
 
+    void MetricsCollector::add_lost_messages(uint64_t count) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.lost_messages += static_cast<size_t>(count);
+    }
+
     void MetricsCollector::update_messages_last_hour() {
         auto now = std::chrono::steady_clock::now();
         auto one_hour_ago = now - std::chrono::hours(1);
@@ -52,6 +57,9 @@ namespace metrics_application {
         // General message statistics
         std::cout << "Total messages: " << stats_.total_messages << std::endl;
         std::cout << "Messages in last hour: " << stats_.messages_last_hour << std::endl;
+        if (stats_.lost_messages > 0) {
+            std::cout << "Lost messages: " << stats_.lost_messages << std::endl;
+        }
 
         // Statistics by level
         std::cout << "\nMessages by log level:" << std::endl;
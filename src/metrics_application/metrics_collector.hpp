@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string_view>
@@ -16,6 +17,7 @@ namespace metrics_application {
 
     public:
         void add_message(std::string_view message, logger::LogLevel level);
+        void add_lost_messages(uint64_t count);
         void print_stats();
         [[nodiscard]] bool should_print_stats(size_t message_interval) const;
         [[nodiscard]] bool has_stats_changed_since_last_print() const;
@@ -0,0 +1,66 @@
+#include "shm_server.hpp"
+
+#include <iostream>
+
+#include <logger/protocol.hpp>
+#include <logger/utility.hpp>
+
+namespace metrics_application {
+    ShmServer::ShmServer(const std::string &name, size_t capacity) : name_(name), capacity_(capacity) {}
+
+    ShmServer::~ShmServer() { stop(); }
+
+    bool ShmServer::start() {
+        ring_ = logger::ShmRing::create(name_, capacity_);
+        if (not ring_) {
+            return false;
+        }
+
+        std::cout << "Waiting for log records in shared memory " << ring_->name() << "..." << std::endl;
+
+        running_ = true;
+        return true;
+    }
+
+    void ShmServer::run() {
+        auto handler = [this](std::string_view record) { handle_record(record); };
+
+        while (running_) {
+            if (ring_->read(handler, READ_BATCH_SIZE) == 0) {
+                ring_->wait(WAIT_TIMEOUT);
+            }
+
+            uint64_t dropped = ring_->dropped_count();
+            if (dropped != reported_dropped_) {
+                if (loss_callback_) {
+                    loss_callback_(dropped - reported_dropped_);
+                }
+                reported_dropped_ = dropped;
+            }
+        }
+    }
+
+    void ShmServer::stop() {
+        running_ = false;
+        // Otherwise run() only notices once its wait times out
+        if (ring_) {
+            ring_->interrupt();
+        }
+    }
+
+    void ShmServer::set_message_callback(MessageCallback callback) { message_callback_ = callback; }
+
+    void ShmServer::set_loss_callback(LossCallback callback) { loss_callback_ = callback; }
+
+    void ShmServer::handle_record(std::string_view record) {
+        logger::protocol::Frame frame;
+        if (not logger::protocol::decode_frame(record, frame)) {
+            std::cerr << "[" << logger::utility::get_current_timestamp() << "] Skipping malformed record" << std::endl;
+            return;
+        }
+
+        if (message_callback_) {
+            message_callback_(frame.payload, frame.level);
+        }
+    }
+} // namespace metrics_application
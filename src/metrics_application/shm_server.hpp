@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include <logger/shm_ring.hpp>
+
+#include "message_server.hpp"
+
+namespace metrics_application {
+    // Reads frames written by ShmSink loggers on the same host from a shared memory ring it owns.
+    // Any number of loggers may come and go while it runs; it sleeps on a futex whenever the ring is empty.
+    class ShmServer : public IMessageServer {
+    public:
+        // `name` is a shared memory object name, with or without the "shm:" prefix
+        explicit ShmServer(const std::string &name, size_t capacity = logger::ShmRing::DEFAULT_CAPACITY);
+        ~ShmServer() override;
+
+    public:
+        bool start() override;
+        void run() override;
+        void stop() override;
+
+        void set_message_callback(MessageCallback callback) override;
+        // Reports messages the loggers dropped because the ring was full
+        void set_loss_callback(LossCallback callback) override;
+
+    private:
+        static constexpr std::chrono::milliseconds WAIT_TIMEOUT{1000};
+        static constexpr size_t READ_BATCH_SIZE = 256;
+
+        void handle_record(std::string_view record);
+
+    private:
+        std::string name_;
+        size_t capacity_;
+        std::unique_ptr<logger::ShmRing> ring_;
+        std::atomic<bool> running_{false};
+        uint64_t reported_dropped_ = 0;
+
+        MessageCallback message_callback_;
+        LossCallback loss_callback_;
+    };
+} // namespace metrics_application
@@ -12,7 +12,10 @@
 
 namespace metrics_application {
     SocketServer::SocketServer(const std::string &host, int port) :
-        host_(host), port_(port), server_fd_(-1), client_fd_(-1), running_(false) {}
+        SocketServer(logger::SocketEndpoint::parse(host, port)) {}
+
+    SocketServer::SocketServer(const logger::SocketEndpoint &endpoint) :
+        endpoint_(endpoint), server_fd_(-1), client_fd_(-1), buffer_(BUFFER_SIZE), running_(false) {}
 
     SocketServer::~SocketServer() { stop(); }
 
@@ -21,9 +24,25 @@ namespace metrics_application {
             return false;
         }
 
-        std::cout << "Waiting for logger connection on " << host_ << ":" << port_ << "..." << std::endl;
+        if (endpoint_.is_udp()) {
+            if (not set_non_blocking(server_fd_)) {
+                return false;
+            }
+
+            datagram_buffers_.resize(DATAGRAMS_PER_RECV * DATAGRAM_BUFFER_SIZE);
+            datagram_iovecs_.resize(DATAGRAMS_PER_RECV);
+            datagram_headers_.resize(DATAGRAMS_PER_RECV);
+            datagram_sources_.resize(DATAGRAMS_PER_RECV);
+
+            std::cout << "Receiving log datagrams on " << endpoint_.to_string() << "..." << std::endl;
+
+            running_ = true;
+            return true;
+        }
+
+        std::cout << "Waiting for logger connection on " << endpoint_.to_string() << "..." << std::endl;
 
-        sockaddr_in client_addr;
+        sockaddr_storage client_addr;
         socklen_t client_addr_len = sizeof(client_addr);
 
         client_fd_ = accept(server_fd_, (sockaddr *) &client_addr, &client_addr_len);
@@ -38,10 +57,15 @@ namespace metrics_application {
             return false;
         }
 
-        char client_ip[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &client_addr.sin_addr, client_ip, INET_ADDRSTRLEN);
+        if (endpoint_.is_unix()) {
+            std::cout << "Logger connected on " << endpoint_.to_string() << std::endl;
+        } else {
+            auto *client_addr_in = reinterpret_cast<sockaddr_in *>(&client_addr);
+            char client_ip[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &client_addr_in->sin_addr, client_ip, INET_ADDRSTRLEN);
 
-        std::cout << "Logger connected from " << client_ip << ":" << ntohs(client_addr.sin_port) << std::endl;
+            std::cout << "Logger connected from " << client_ip << ":" << ntohs(client_addr_in->sin_port) << std::endl;
+        }
         std::cout << "Receiving log messages..." << std::endl;
 
         running_ = true;
@@ -49,8 +73,10 @@ namespace metrics_application {
     }
 
     void SocketServer::run() {
+        bool is_udp = endpoint_.is_udp();
+
         pollfd poll_fd;
-        poll_fd.fd = client_fd_;
+        poll_fd.fd = is_udp ? server_fd_ : client_fd_;
         poll_fd.events = POLLIN;
 
         while (running_) {
@@ -71,7 +97,11 @@ namespace metrics_application {
             }
 
             if (poll_fd.revents & POLLIN) {
-                handle_recv();
+                if (is_udp) {
+                    handle_datagrams();
+                } else {
+                    handle_recv();
+                }
             }
 
             if (poll_fd.revents & (POLLHUP | POLLERR | POLLNVAL)) {
@@ -92,46 +122,55 @@ namespace metrics_application {
         if (server_fd_ != -1) {
             close(server_fd_);
             server_fd_ = -1;
+
+            if (endpoint_.is_unix()) {
+                unlink(endpoint_.address.c_str());
+            }
         }
     }
 
     void SocketServer::set_message_callback(MessageCallback callback) { message_callback_ = callback; }
 
+    void SocketServer::set_loss_callback(LossCallback callback) { loss_callback_ = callback; }
+
     bool SocketServer::init_socket() {
-        server_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        server_fd_ = socket(endpoint_.address_family(), endpoint_.socket_type(), 0);
         if (server_fd_ == -1) {
             std::cerr << "Failed to create socket: " << strerror(errno) << std::endl;
             return false;
         }
 
         int opt = 1;
-        if (setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1) {
+        if (not endpoint_.is_unix() && setsockopt(server_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1) {
             std::cerr << "Failed to set SO_REUSEADDR: " << strerror(errno) << std::endl;
             close(server_fd_);
             server_fd_ = -1;
             return false;
         }
 
-        sockaddr_in server_addr;
-        memset(&server_addr, 0, sizeof(server_addr));
-        server_addr.sin_family = AF_INET;
-        server_addr.sin_port = htons(port_);
+        sockaddr_storage server_addr;
+        socklen_t server_addr_len;
 
-        if (inet_pton(AF_INET, host_.c_str(), &server_addr.sin_addr) <= 0) {
-            std::cerr << "Invalid host address: " << host_ << std::endl;
+        if (not endpoint_.to_sockaddr(server_addr, server_addr_len)) {
+            std::cerr << "Invalid host address: " << endpoint_.address << std::endl;
             close(server_fd_);
             server_fd_ = -1;
             return false;
         }
 
-        if (bind(server_fd_, (sockaddr *) &server_addr, sizeof(server_addr)) == -1) {
+        // A socket file left behind by a previous run would make bind() fail
+        if (endpoint_.is_unix()) {
+            unlink(endpoint_.address.c_str());
+        }
+
+        if (bind(server_fd_, (sockaddr *) &server_addr, server_addr_len) == -1) {
             std::cerr << "Failed to bind socket: " << strerror(errno) << std::endl;
             close(server_fd_);
             server_fd_ = -1;
             return false;
         }
 
-        if (listen(server_fd_, 1) == -1) {
+        if (not endpoint_.is_udp() && listen(server_fd_, 1) == -1) {
             std::cerr << "Failed to listen on socket: " << strerror(errno) << std::endl;
             close(server_fd_);
             server_fd_ = -1;
@@ -152,7 +191,7 @@ namespace metrics_application {
     }
 
     void SocketServer::handle_recv() {
-        char buffer[BUFFER_SIZE];
+        char *buffer = buffer_.data();
 
         while (true) {
             ssize_t bytes_read = recv(client_fd_, buffer, BUFFER_SIZE, 0);
@@ -170,17 +209,130 @@ namespace metrics_application {
                 break;
             }
 
-            client_buffer_.insert(client_buffer_.end(), buffer, buffer + bytes_read);
+            decoder_.feed(buffer, static_cast<size_t>(bytes_read));
+
+            logger::protocol::Frame frame;
+            while (decoder_.next(frame)) {
+                if (message_callback_) {
+                    message_callback_(frame.payload, frame.level);
+                }
+            }
+
+            if (decoder_.has_error()) {
+                std::cerr << "Malformed frame received, closing connection" << std::endl;
+                stop();
+                return;
+            }
         }
+    }
 
-        if (!client_buffer_.empty()) {
-            std::string_view message(client_buffer_.data(), client_buffer_.size());
+    void SocketServer::handle_datagrams() {
+        while (running_) {
+            for (size_t i = 0; i < DATAGRAMS_PER_RECV; ++i) {
+                datagram_iovecs_[i].iov_base = datagram_buffers_.data() + i * DATAGRAM_BUFFER_SIZE;
+                datagram_iovecs_[i].iov_len = DATAGRAM_BUFFER_SIZE;
+
+                datagram_headers_[i] = mmsghdr{};
+                datagram_headers_[i].msg_hdr.msg_iov = &datagram_iovecs_[i];
+                datagram_headers_[i].msg_hdr.msg_iovlen = 1;
+                datagram_headers_[i].msg_hdr.msg_name = &datagram_sources_[i];
+                datagram_headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+            }
 
+            int received = recvmmsg(server_fd_, datagram_headers_.data(), DATAGRAMS_PER_RECV, MSG_DONTWAIT, nullptr);
+            if (received == -1) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    std::cerr << "Error reading datagrams: " << strerror(errno) << std::endl;
+                }
+                return;
+            }
+
+            for (int i = 0; i < received; ++i) {
+                handle_datagram(datagram_sources_[i],
+                                std::string_view(static_cast<const char *>(datagram_iovecs_[i].iov_base),
+                                                 datagram_headers_[i].msg_len));
+            }
+
+            if (static_cast<size_t>(received) < DATAGRAMS_PER_RECV) {
+                return; // drained
+            }
+        }
+    }
+
+    void SocketServer::handle_datagram(const sockaddr_storage &source, std::string_view datagram) {
+        uint32_t first_sequence;
+        if (not logger::protocol::decode_datagram_header(datagram, first_sequence)) {
+            ++malformed_datagrams_;
+            std::cerr << "Malformed datagram dropped (" << malformed_datagrams_ << " so far)" << std::endl;
+            return;
+        }
+        datagram.remove_prefix(logger::protocol::DATAGRAM_HEADER_SIZE);
+
+        // Validate everything first, so a corrupt datagram is dropped as a whole
+        size_t message_count = 0;
+        logger::protocol::Frame frame;
+        for (std::string_view rest = datagram; not rest.empty(); ++message_count) {
+            if (not logger::protocol::decode_frame(rest, frame)) {
+                ++malformed_datagrams_;
+                std::cerr << "Malformed datagram dropped (" << malformed_datagrams_ << " so far)" << std::endl;
+                return;
+            }
+            rest.remove_prefix(logger::protocol::HEADER_SIZE + frame.payload.size());
+        }
+
+        // Messages from a sender that cannot be told apart from others are still delivered, only not tracked
+        SourceKey source_key;
+        if (make_source_key(source, source_key)) {
+            track_sequence(source_key, first_sequence, message_count);
+        }
+
+        while (not datagram.empty()) {
+            logger::protocol::decode_frame(datagram, frame);
             if (message_callback_) {
-                message_callback_(message);
+                message_callback_(frame.payload, frame.level);
+            }
+            datagram.remove_prefix(logger::protocol::HEADER_SIZE + frame.payload.size());
+        }
+    }
+
+    bool SocketServer::make_source_key(const sockaddr_storage &source, SourceKey &key) {
+        key.fill(0);
+        std::memcpy(key.data(), &source.ss_family, sizeof(source.ss_family));
+
+        if (source.ss_family == AF_INET) {
+            const auto &address = reinterpret_cast<const sockaddr_in &>(source);
+            std::memcpy(key.data() + 2, &address.sin_port, sizeof(address.sin_port));
+            std::memcpy(key.data() + 4, &address.sin_addr, sizeof(address.sin_addr));
+            return true;
+        }
+        if (source.ss_family == AF_INET6) {
+            const auto &address = reinterpret_cast<const sockaddr_in6 &>(source);
+            std::memcpy(key.data() + 2, &address.sin6_port, sizeof(address.sin6_port));
+            std::memcpy(key.data() + 4, &address.sin6_addr, sizeof(address.sin6_addr));
+            return true;
+        }
+        return false;
+    }
+
+    void SocketServer::track_sequence(const SourceKey &source, uint32_t first_sequence, size_t message_count) {
+        auto [entry, inserted] = next_sequence_.try_emplace(source, first_sequence);
+        uint32_t end_sequence = first_sequence + static_cast<uint32_t>(message_count);
+
+        // Sequence numbers wrap around, so anything less than half the range ahead counts as ahead
+        auto distance = static_cast<uint32_t>(first_sequence - entry->second);
+        if (distance < 0x80000000u) {
+            if (distance > 0 && loss_callback_) {
+                loss_callback_(distance);
             }
+            entry->second = end_sequence;
+            return;
+        }
 
-            client_buffer_.clear();
+        // A duplicate or a datagram overtaken by a later one: what it carries was either counted already or
+        // reported as lost, and stays that way. Only messages past the highest sequence seen are new.
+        auto beyond = static_cast<uint32_t>(end_sequence - entry->second);
+        if (beyond > 0 && beyond < 0x80000000u) {
+            entry->second = end_sequence;
         }
     }
 } // namespace metrics_application
@@ -1,43 +1,81 @@
 #pragma once
 
-#include <functional>
+#include <array>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
-namespace metrics_application {
-    class SocketServer {
-    public:
-        using MessageCallback = std::function<void(std::string_view)>;
+#include <sys/socket.h>
+
+#include <logger/protocol.hpp>
+#include <logger/socket_endpoint.hpp>
+
+#include "message_server.hpp"
 
+namespace metrics_application {
+    class SocketServer : public IMessageServer {
     public:
+        // `host` may also be a "unix:<path>" or "seqpacket:<path>" address, the port is ignored then.
+        // With a "udp:<address>" host the server receives datagrams from any number of UdpSink loggers
+        // instead of accepting one connection, and reports gaps in their sequence numbers as losses.
         SocketServer(const std::string &host, int port);
-        ~SocketServer();
+        explicit SocketServer(const logger::SocketEndpoint &endpoint);
+        ~SocketServer() override;
 
     public:
-        bool start();
-        void run();
-        void stop();
+        bool start() override;
+        void run() override;
+        void stop() override;
 
-        // Set callback for when a message is received
-        void set_message_callback(MessageCallback callback);
+        // Set callback for every complete frame received; frames split or merged by TCP are reassembled first
+        void set_message_callback(MessageCallback callback) override;
+        void set_loss_callback(LossCallback callback) override;
 
     private:
         static constexpr int POLL_TIMEOUT_MS = 1000;
-        static constexpr size_t BUFFER_SIZE = 4096;
+        // Large enough for a whole SOCK_SEQPACKET record, which recv() would truncate otherwise
+        static constexpr size_t BUFFER_SIZE = logger::SocketEndpoint::MAX_SEQPACKET_SIZE;
+        // Datagrams pulled per recvmmsg() call, each into its own buffer large enough for any UDP datagram
+        static constexpr size_t DATAGRAMS_PER_RECV = 32;
+        static constexpr size_t DATAGRAM_BUFFER_SIZE = 64 * 1024;
+
+        // Family, port and address of a datagram sender as raw bytes, room enough for IPv6
+        using SourceKey = std::array<char, 20>;
+        struct SourceKeyHash {
+            size_t operator()(const SourceKey &key) const {
+                return std::hash<std::string_view>()(std::string_view(key.data(), key.size()));
+            }
+        };
+        // Returns false for address families it cannot tell senders apart in
+        static bool make_source_key(const sockaddr_storage &source, SourceKey &key);
 
         bool init_socket();
         bool set_non_blocking(int socket);
         void handle_recv();
+        void handle_datagrams();
+        void handle_datagram(const sockaddr_storage &source, std::string_view datagram);
+        void track_sequence(const SourceKey &source, uint32_t first_sequence, size_t message_count);
 
     private:
-        std::string host_;
-        int port_;
+        logger::SocketEndpoint endpoint_;
         int server_fd_;
         int client_fd_;
-        std::vector<char> client_buffer_;
+        std::vector<char> buffer_;
+        logger::protocol::FrameDecoder decoder_;
         bool running_;
 
+        // UDP mode
+        std::vector<char> datagram_buffers_;
+        std::vector<iovec> datagram_iovecs_;
+        std::vector<mmsghdr> datagram_headers_;
+        std::vector<sockaddr_storage> datagram_sources_;
+        // Next expected message sequence number per sender address
+        std::unordered_map<SourceKey, uint32_t, SourceKeyHash> next_sequence_;
+        uint64_t malformed_datagrams_ = 0;
+
         MessageCallback message_callback_;
+        LossCallback loss_callback_;
     };
 } // namespace metrics_application
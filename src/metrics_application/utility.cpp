@@ -7,15 +7,23 @@
 namespace metrics_application {
     namespace utility {
         void print_usage(const char *program_name) {
-            std::cout << "Usage: " << program_name << " <host> <port> <N> <T>\n\n";
+            std::cout << "Usage: " << program_name << " <host> <port> <N> <T>\n";
+            std::cout << "       " << program_name << " unix:<path>|seqpacket:<path>|shm:<name> <N> <T>\n\n";
             std::cout << "Parameters:\n";
-            std::cout << "  host - Host address to bind to (e.g., 127.0.0.1, 0.0.0.0)\n";
+            std::cout << "  host - Host address to bind to (e.g., 127.0.0.1, 0.0.0.0), "
+                         "udp:<address> to receive UDP datagrams\n";
             std::cout << "  port - Port number to listen on\n";
+            std::cout << "  unix:<path>      - Listen on a Unix domain stream socket instead of TCP\n";
+            std::cout << "  seqpacket:<path> - Listen on a Unix domain SOCK_SEQPACKET socket instead of TCP\n";
+            std::cout << "  shm:<name>       - Read from a shared memory ring written by loggers on this host\n";
             std::cout << "  N    - Print stats after every N messages\n";
             std::cout << "  T    - Print stats after T seconds of timeout (if stats changed)\n\n";
             std::cout << "Examples:\n";
             std::cout << "  " << program_name << " 127.0.0.1 9000 10 30\n";
             std::cout << "    (Print stats every 10 messages or after 30 seconds of inactivity)\n";
+            std::cout << "  " << program_name << " udp:0.0.0.0 9000 10 30\n";
+            std::cout << "  " << program_name << " unix:/tmp/logger.sock 10 30\n";
+            std::cout << "  " << program_name << " shm:logger 10 30\n";
         }
 
         std::optional<logger::LogLevel> parse_level_from_log(std::string_view log_message) {
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include <logger/shm_ring.hpp>
+#include <logger/socket_endpoint.hpp>
 #include <logger/utility.hpp>
 
 namespace test_application {
@@ -62,6 +64,19 @@ namespace test_application {
 
     std::optional<AppConfig> ArgumentParser::parse_socket_mode(const std::vector<std::string> &args,
                                                                size_t start_index) {
+        // "unix:<path>", "seqpacket:<path>" and "shm:<name>" addresses need no port
+        if (args.size() > start_index && (logger::SocketEndpoint::is_unix_address(args[start_index]) ||
+                                          logger::ShmRing::is_shm_address(args[start_index]))) {
+            AppConfig config(AppConfig::Mode::SOCKET);
+            config.host = args[start_index];
+
+            if (not parse_optional_level(args, start_index + 1, config)) {
+                return std::nullopt;
+            }
+
+            return config;
+        }
+
         if (args.size() <= start_index + 1) {
             print_error("Missing host or port for --socket option");
             return std::nullopt;
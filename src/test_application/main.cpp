@@ -1,5 +1,9 @@
 #include <iostream>
 
+#include <logger/crash_handler.hpp>
+#include <logger/shm_ring.hpp>
+#include <logger/socket_endpoint.hpp>
+
 #include "argument_parser.hpp"
 #include "command_parser.hpp"
 #include "test_application.hpp"
@@ -32,12 +36,18 @@ int main(int argc, char *argv[]) {
     } else if (config->mode == AppConfig::Mode::SOCKET) {
         testApplication = TestApplication::create_application(config->host, config->port, config->level);
         if (not testApplication) {
-            std::cerr << "Failed to create Test application with socket: " << config->host << ":" << config->port
+            std::cerr << "Failed to create Test application with "
+                      << (logger::ShmRing::is_shm_address(config->host)
+                                  ? "shared memory ring: " + logger::ShmRing::object_name(config->host)
+                                  : "socket: " + logger::SocketEndpoint::parse(config->host, config->port).to_string())
                       << std::endl;
             return 1;
         }
     }
 
+    // Log buffers still in memory are written out if the process is killed or crashes
+    logger::CrashHandler::install();
+
     testApplication->run();
 
     return 0;
@@ -33,7 +33,8 @@ namespace test_application {
     }
 
     TestApplication::TestApplication(std::shared_ptr<logger::Logger> logger, logger::LogLevel default_level) :
-        logger_(std::move(logger)), default_level_(default_level) {}
+        logger_(std::move(logger)), log_queue_(queue_options_), last_drop_report_(std::chrono::steady_clock::now()),
+        default_level_(default_level) {}
 
     TestApplication::~TestApplication() { stop(); }
 
@@ -75,6 +76,12 @@ namespace test_application {
             case CommandType::LOG_MESSAGE: {
                 logger::LogLevel level = command.level.value_or(default_level_);
                 log_queue_.push(LogEntry(command.message, level));
+
+                // The process may not outlive a fatal message, so wait until it and everything queued before it
+                // went through the logger, which flushes its sinks on FATAL
+                if (level == logger::LogLevel::FATAL) {
+                    log_queue_.wait_until_done();
+                }
                 break;
             }
 
@@ -93,16 +100,39 @@ namespace test_application {
 
         while (is_running_.load()) {
             if (log_queue_.pop(entry)) {
-                if (logger_ && logger_->is_valid()) {
-                    logger_->log(entry.message, entry.level);
-                }
+                write_entry(entry);
+                log_queue_.task_done();
+                report_drops(false);
             }
         }
 
         while (log_queue_.pop(entry)) {
-            if (logger_ && logger_->is_valid()) {
-                logger_->log(entry.message, entry.level);
-            }
+            write_entry(entry);
+            log_queue_.task_done();
+        }
+        report_drops(true);
+    }
+
+    void TestApplication::write_entry(const LogEntry &entry) {
+        if (logger_ && logger_->is_valid()) {
+            logger_->log(entry.message, entry.level);
+        }
+    }
+
+    void TestApplication::report_drops(bool force) {
+        auto now = std::chrono::steady_clock::now();
+        if (queue_options_.report_interval.count() <= 0 ||
+            (not force && now - last_drop_report_ < queue_options_.report_interval)) {
+            return;
+        }
+        last_drop_report_ = now;
+
+        auto current = log_queue_.drop_counters().snapshot();
+        std::string summary = logger::DropCounters::describe(current, reported_drops_);
+        reported_drops_ = current;
+
+        if (not summary.empty()) {
+            write_entry(LogEntry(summary, logger::LogLevel::WARNING));
         }
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <thread>
@@ -35,10 +36,16 @@ namespace test_application {
     private:
         void process_command(const ParsedCommand &command);
         void worker_thread_function();
+        void write_entry(const LogEntry &entry);
+        // Logs a summary of entries the queue dropped since the last one, at most once per report interval
+        void report_drops(bool force);
 
     private:
         std::shared_ptr<logger::Logger> logger_;
+        logger::QueueOptions queue_options_;
         ThreadSafeQueue<LogEntry> log_queue_;
+        logger::DropCounters::Snapshot reported_drops_{};
+        std::chrono::steady_clock::time_point last_drop_report_;
         logger::LogLevel default_level_;
         std::thread worker_thread_;
         std::atomic<bool> is_running_{false};
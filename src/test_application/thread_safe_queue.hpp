@@ -1,46 +1,88 @@
 #pragma once
 
+#include <array>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
 
+#include <logger/backpressure.hpp>
+
 namespace test_application {
+    // Bounded blocking queue with one FIFO lane per LogLevel: pop() serves the most severe waiting item first, so
+    // an ERROR does not queue up behind a flood of DEBUG lines. Every waiting lane still gets an item through once
+    // QueueOptions::starvation_limit items were taken ahead of it.
+    //
+    // What happens to an item pushed while the queue is full is decided by the overflow policy in QueueOptions;
+    // items at never_drop_level or above are always accepted. T needs a `level` member.
     template<typename T>
     class ThreadSafeQueue {
     public:
-        ThreadSafeQueue() : is_running_(true) {}
+        explicit ThreadSafeQueue(const logger::QueueOptions &options = logger::QueueOptions()) :
+            options_(options), is_running_(true) {}
 
         ~ThreadSafeQueue() { stop(); }
 
+        // Returns false if the item was dropped or the queue is stopped
         template<typename U>
-        void push(U &&item) {
-            std::lock_guard<std::mutex> lock(mutex_);
+        bool push(U &&item) {
+            std::unique_lock<std::mutex> lock(mutex_);
             if (not is_running_) {
-                return;
+                return false;
             }
-            queue_.push(std::forward<U>(item));
-            condition_.notify_one();
+
+            bool droppable = item.level < options_.never_drop_level;
+            if (droppable && size_ >= options_.capacity && not make_room(lock, item.level)) {
+                if (is_running_) {
+                    dropped_.add(item.level);
+                }
+                return false;
+            }
+
+            lanes_[lane_of(item.level)].push(std::forward<U>(item));
+            ++size_;
+            ++unfinished_;
+            not_empty_.notify_one();
+            return true;
         }
 
         bool pop(T &item) {
             std::unique_lock<std::mutex> lock(mutex_);
 
-            condition_.wait(lock, [this] { return not queue_.empty() || not is_running_; });
+            not_empty_.wait(lock, [this] { return size_ > 0 || not is_running_; });
 
-            if (not is_running_ && queue_.empty()) {
+            if (not is_running_ && size_ == 0) {
                 return false;
             }
 
-            item = std::move(queue_.front());
-            queue_.pop();
+            auto &lane = lanes_[next_lane()];
+            item = std::move(lane.front());
+            lane.pop();
+            --size_;
+            not_full_.notify_one();
 
             return true;
         }
 
+        // Called by the consumer once it is done with an item taken by pop()
+        void task_done() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (unfinished_ > 0 && --unfinished_ == 0) {
+                all_done_.notify_all();
+            }
+        }
+
+        // Blocks until every accepted item was popped and marked with task_done(), or the queue is stopped
+        void wait_until_done() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            all_done_.wait(lock, [this] { return unfinished_ == 0 || not is_running_; });
+        }
+
         void stop() {
             std::lock_guard<std::mutex> lock(mutex_);
             is_running_ = false;
-            condition_.notify_all();
+            not_empty_.notify_all();
+            not_full_.notify_all();
+            all_done_.notify_all();
         }
 
         bool is_running() const {
@@ -50,18 +92,96 @@ namespace test_application {
 
         size_t size() const {
             std::lock_guard<std::mutex> lock(mutex_);
-            return queue_.size();
+            return size_;
         }
 
         bool empty() const {
             std::lock_guard<std::mutex> lock(mutex_);
-            return queue_.empty();
+            return size_ == 0;
+        }
+
+        // Items lost to the overflow policy, per level; readable without the queue lock
+        const logger::DropCounters &drop_counters() const { return dropped_; }
+
+    private:
+        static constexpr size_t LANE_COUNT = logger::DropCounters::LEVEL_COUNT;
+
+        static size_t lane_of(logger::LogLevel level) { return static_cast<size_t>(level); }
+
+        // Expects mutex_ to be held and the queue not to be empty
+        size_t next_lane() {
+            // The most severe lane, unless a waiting lane was bypassed starvation_limit times; of several such
+            // lanes the one bypassed most often goes first
+            size_t chosen = LANE_COUNT;
+            for (size_t lane = LANE_COUNT; lane-- > 0;) {
+                if (lanes_[lane].empty()) {
+                    bypassed_[lane] = 0;
+                    continue;
+                }
+                if (chosen == LANE_COUNT) {
+                    chosen = lane;
+                }
+                if (options_.starvation_limit > 0 && bypassed_[lane] >= options_.starvation_limit &&
+                    (bypassed_[chosen] < options_.starvation_limit || bypassed_[lane] > bypassed_[chosen])) {
+                    chosen = lane;
+                }
+            }
+
+            for (size_t lane = 0; lane < LANE_COUNT; ++lane) {
+                if (lane != chosen && not lanes_[lane].empty()) {
+                    ++bypassed_[lane];
+                }
+            }
+            bypassed_[chosen] = 0;
+            return chosen;
+        }
+
+        // Expects mutex_ to be held through `lock`; returns true once there is room for an item of `level`
+        bool make_room(std::unique_lock<std::mutex> &lock, logger::LogLevel level) {
+            if (level < options_.drop_below || options_.policy == logger::OverflowPolicy::DROP_NEWEST) {
+                return false;
+            }
+
+            if (options_.policy == logger::OverflowPolicy::DROP_OLDEST) {
+                // Oldest item of the least severe lane, never one more severe than the incoming item, which is
+                // dropped instead. `level` is below never_drop_level, so protected lanes are never touched.
+                for (size_t lane = 0; lane <= lane_of(level); ++lane) {
+                    if (not lanes_[lane].empty()) {
+                        dropped_.add(lanes_[lane].front().level);
+                        lanes_[lane].pop();
+                        --size_;
+                        --unfinished_;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            auto has_room = [this] { return size_ < options_.capacity || not is_running_; };
+            if (options_.block_timeout.count() > 0) {
+                if (not not_full_.wait_for(lock, options_.block_timeout, has_room)) {
+                    return false;
+                }
+            } else {
+                not_full_.wait(lock, has_room);
+            }
+
+            return is_running_;
         }
 
     private:
-        std::queue<T> queue_;
+        std::array<std::queue<T>, LANE_COUNT> lanes_;
+        size_t size_ = 0;
+        // Accepted items not yet marked with task_done()
+        size_t unfinished_ = 0;
+        // Per lane, items taken ahead of it while it was waiting since it was last served
+        std::array<size_t, LANE_COUNT> bypassed_{};
+        logger::QueueOptions options_;
+        logger::DropCounters dropped_;
         mutable std::mutex mutex_;
-        std::condition_variable condition_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::condition_variable all_done_;
         bool is_running_;
     };
 } // namespace test_application
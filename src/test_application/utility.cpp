@@ -8,11 +8,16 @@ namespace test_application {
             std::cout << "Usage:\n";
             std::cout << "  " << program_name << " --file <filename> [--level <level>]\n";
             std::cout << "  " << program_name << " --socket <host> <port> [--level <level>]\n";
+            std::cout << "  " << program_name << " --socket unix:<path>|seqpacket:<path> [--level <level>]\n";
+            std::cout << "  " << program_name << " --socket shm:<name> [--level <level>]\n";
             std::cout << "  " << program_name << " --help\n\n";
 
             std::cout << "Options:\n";
             std::cout << "  --file <filename>      Log to file\n";
-            std::cout << "  --socket <host> <port> Log to socket server\n";
+            std::cout << "  --socket <host> <port> Log to socket server (udp:<host> <port> to send UDP datagrams)\n";
+            std::cout << "  --socket unix:<path>   Log to a local Unix domain socket "
+                         "(seqpacket:<path> for SOCK_SEQPACKET)\n";
+            std::cout << "  --socket shm:<name>    Log into the shared memory ring of a local metrics_application\n";
             std::cout << "  --level <level>        Set default log level (debug, info, warning, error, fatal) "
                          "(Default: info)\n";
             std::cout << "  --help, -h             Show this help\n\n";
@@ -21,6 +26,8 @@ namespace test_application {
             std::cout << "  " << program_name << " --file app.log\n";
             std::cout << "  " << program_name << " --file app.log --level debug\n";
             std::cout << "  " << program_name << " --socket 127.0.0.1 9000 --level error\n";
+            std::cout << "  " << program_name << " --socket udp:127.0.0.1 9000 --level debug\n";
+            std::cout << "  " << program_name << " --socket unix:/tmp/logger.sock\n";
         }
 
         void print_help() {
@@ -0,0 +1,174 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/async_sink.hpp>
+#include <logger/logger.hpp>
+
+#include "test_directory.hpp"
+
+namespace {
+    // Records every line it receives; optionally sleeps on each batch to simulate a stalled destination
+    class RecordingSink : public logger::ILogSink {
+    public:
+        explicit RecordingSink(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : delay_(delay) {}
+
+        void write(std::string_view message) override {
+            std::this_thread::sleep_for(delay_);
+            std::lock_guard<std::mutex> lock(mutex_);
+            lines_.emplace_back(message);
+        }
+
+        bool is_valid() const override { return true; }
+
+        std::vector<std::string> lines() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lines_;
+        }
+
+    private:
+        std::chrono::milliseconds delay_;
+        mutable std::mutex mutex_;
+        std::vector<std::string> lines_;
+    };
+} // namespace
+
+TEST(AsyncSinkTest, Flush_DeliversAllMessagesInOrder) {
+    auto recording = std::make_unique<RecordingSink>();
+    auto *recording_ptr = recording.get();
+    logger::AsyncSink sink(std::move(recording));
+
+    for (int i = 0; i < 1000; ++i) {
+        sink.write("Message " + std::to_string(i));
+    }
+    sink.flush();
+
+    auto lines = recording_ptr->lines();
+    ASSERT_EQ(lines.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(lines[i], "Message " + std::to_string(i));
+    }
+}
+
+TEST(AsyncSinkTest, IsValid_ReflectsWrappedSink) {
+    logger::AsyncSink valid_sink(std::make_unique<RecordingSink>());
+    EXPECT_TRUE(valid_sink.is_valid());
+
+    logger::AsyncSink empty_sink(nullptr);
+    EXPECT_FALSE(empty_sink.is_valid());
+}
+
+TEST(AsyncSinkTest, FullQueue_DropsInsteadOfBlocking) {
+    logger::AsyncSink sink(std::make_unique<RecordingSink>(std::chrono::milliseconds(50)), 4);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        sink.write("Message");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::milliseconds(50));
+    EXPECT_GT(sink.dropped_count(), 0u);
+}
+
+TEST(AsyncSinkTest, FullQueue_NeverDropsErrors) {
+    auto recording = std::make_unique<RecordingSink>(std::chrono::milliseconds(1));
+    auto *recording_ptr = recording.get();
+    logger::AsyncSink sink(std::move(recording), 4);
+
+    std::vector<logger::SinkMessage> batch;
+    std::vector<std::string> texts;
+    for (int i = 0; i < 20; ++i) {
+        texts.push_back("Info " + std::to_string(i));
+        texts.push_back("Error " + std::to_string(i));
+    }
+    for (size_t i = 0; i < texts.size(); ++i) {
+        batch.push_back({texts[i], i % 2 == 0 ? logger::LogLevel::INFO : logger::LogLevel::ERROR, {}});
+    }
+    sink.write_batch(batch);
+    sink.flush();
+
+    size_t errors = 0;
+    for (const auto &line: recording_ptr->lines()) {
+        errors += line.rfind("Error ", 0) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(errors, 20u);
+    EXPECT_GT(sink.drop_counters().count(logger::LogLevel::INFO), 0u);
+    EXPECT_EQ(sink.drop_counters().count(logger::LogLevel::ERROR), 0u);
+    EXPECT_EQ(sink.dropped_count(), sink.drop_counters().total());
+}
+
+TEST(AsyncSinkTest, BlockPolicy_DeliversEverything) {
+    auto recording = std::make_unique<RecordingSink>(std::chrono::milliseconds(1));
+    auto *recording_ptr = recording.get();
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::BLOCK;
+    logger::AsyncSink sink(std::move(recording), options);
+
+    for (int i = 0; i < 50; ++i) {
+        sink.write("Message " + std::to_string(i));
+    }
+    sink.flush();
+
+    EXPECT_EQ(recording_ptr->lines().size(), 50u);
+    EXPECT_EQ(sink.dropped_count(), 0u);
+}
+
+TEST(AsyncSinkTest, Drops_SummedUpInWrappedSink) {
+    auto recording = std::make_unique<RecordingSink>(std::chrono::milliseconds(5));
+    auto *recording_ptr = recording.get();
+    logger::QueueOptions options(2);
+    options.policy = logger::OverflowPolicy::DROP_NEWEST;
+    options.report_interval = std::chrono::milliseconds(1);
+    logger::AsyncSink sink(std::move(recording), options);
+
+    for (int i = 0; i < 10; ++i) {
+        sink.write("Message");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sink.flush();
+
+    bool reported = false;
+    for (const auto &line: recording_ptr->lines()) {
+        reported = reported || line.find("[WARNING] Dropped") != std::string::npos;
+    }
+    EXPECT_TRUE(reported);
+}
+
+TEST(AsyncSinkTest, SlowSink_DoesNotDelayOtherSinks) {
+    TestDirectory directory;
+    auto logger = logger::Logger::create_logger(directory.file("test_async_sink.log"), logger::LogLevel::DEBUG);
+    ASSERT_NE(logger, nullptr);
+    logger->clear_sinks();
+
+    auto fast = std::make_unique<RecordingSink>();
+    auto *fast_ptr = fast.get();
+    auto slow = std::make_unique<RecordingSink>(std::chrono::milliseconds(20));
+    auto *slow_ptr = slow.get();
+
+    logger->add_sink(std::move(fast));
+    logger->add_sink(std::make_unique<logger::AsyncSink>(std::move(slow)), logger::LogLevel::WARNING);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        logger->debug("Debug message");
+        logger->warning("Warning message");
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+    EXPECT_EQ(fast_ptr->lines().size(), 20u);
+
+    logger->flush();
+    auto slow_lines = slow_ptr->lines();
+    ASSERT_EQ(slow_lines.size(), 10u);
+    for (const auto &line: slow_lines) {
+        EXPECT_NE(line.find("[WARNING]"), std::string::npos);
+    }
+}
@@ -0,0 +1,301 @@
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/backpressure.hpp>
+#include <logger/logger.hpp>
+
+#include "test_directory.hpp"
+
+namespace {
+    // Holds the backend thread inside write_batch() until released, so the logger queue fills up deterministically
+    class GatedSink : public logger::ILogSink {
+    public:
+        void write(std::string_view message) override {
+            write_batch({logger::SinkMessage{message, logger::LogLevel::INFO, {}}});
+        }
+
+        void write_batch(const std::vector<logger::SinkMessage> &messages) override {
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (const auto &message: messages) {
+                lines_.emplace_back(message.text);
+            }
+            entered_ = true;
+            condition_.notify_all();
+            condition_.wait(lock, [this] { return open_; });
+        }
+
+        bool is_valid() const override { return true; }
+
+        void wait_until_entered() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return entered_; });
+        }
+
+        void open() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+            condition_.notify_all();
+        }
+
+        std::vector<std::string> lines() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lines_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool entered_ = false;
+        bool open_ = false;
+        std::vector<std::string> lines_;
+    };
+
+    bool contains(const std::vector<std::string> &lines, const std::string &text) {
+        for (const auto &line: lines) {
+            if (line.find(text) != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+class BackpressureTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::filesystem::remove(filename_); }
+
+    // Creates an async logger whose backend is stuck in a GatedSink after the first message,
+    // leaving exactly `capacity` free slots in the queue
+    std::shared_ptr<logger::Logger> create_stalled_logger(logger::QueueOptions options) {
+        auto log = logger::Logger::create_async_logger(filename_, logger::LogLevel::DEBUG, options);
+        auto gate = std::make_unique<GatedSink>();
+        gate_ = gate.get();
+        log->add_sink(std::move(gate));
+
+        log->info("first");
+        gate_->wait_until_entered();
+        return log;
+    }
+
+    TestDirectory directory_;
+    std::string filename_ = directory_.file("test_backpressure.log");
+    GatedSink *gate_ = nullptr;
+};
+
+TEST(DropCountersTest, Describe_SummarizesNewDropsPerLevel) {
+    logger::DropCounters counters;
+    auto before = counters.snapshot();
+    EXPECT_EQ(logger::DropCounters::describe(counters.snapshot(), before), "");
+
+    counters.add(logger::LogLevel::DEBUG, 10);
+    counters.add(logger::LogLevel::INFO, 2);
+
+    EXPECT_EQ(counters.total(), 12u);
+    EXPECT_EQ(counters.count(logger::LogLevel::DEBUG), 10u);
+    EXPECT_EQ(logger::DropCounters::describe(counters.snapshot(), before),
+              "Dropped 12 messages due to queue overflow (DEBUG: 10, INFO: 2)");
+}
+
+TEST_F(BackpressureTest, DropNewest_KeepsQueuedMessages) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_NEWEST;
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 10; ++i) {
+        log->debug("message " + std::to_string(i));
+    }
+    EXPECT_EQ(log->dropped_count(), 6u);
+    EXPECT_EQ(log->dropped_count(logger::LogLevel::DEBUG), 6u);
+
+    gate_->open();
+    log->flush();
+
+    auto lines = gate_->lines();
+    EXPECT_TRUE(contains(lines, "message 3"));
+    EXPECT_FALSE(contains(lines, "message 4"));
+}
+
+TEST_F(BackpressureTest, DropOldest_KeepsLatestMessages) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_OLDEST;
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 10; ++i) {
+        log->info("message " + std::to_string(i));
+    }
+    EXPECT_EQ(log->dropped_count(logger::LogLevel::INFO), 6u);
+
+    gate_->open();
+    log->flush();
+
+    auto lines = gate_->lines();
+    EXPECT_FALSE(contains(lines, "message 5"));
+    EXPECT_TRUE(contains(lines, "message 6"));
+    EXPECT_TRUE(contains(lines, "message 9"));
+}
+
+TEST_F(BackpressureTest, BlockWithTimeout_DropsAfterWaiting) {
+    logger::QueueOptions options(4);
+    options.block_timeout = std::chrono::milliseconds(20);
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 4; ++i) {
+        log->info("fits " + std::to_string(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    log->info("times out");
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_EQ(log->dropped_count(), 1u);
+
+    gate_->open();
+    log->flush();
+    EXPECT_FALSE(contains(gate_->lines(), "times out"));
+}
+
+TEST_F(BackpressureTest, Block_ParkedProducersResumeOnceBackendMakesRoom) {
+    auto log = create_stalled_logger(logger::QueueOptions(4));
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&log, t] {
+            for (int i = 0; i < 50; ++i) {
+                log->info("producer " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate_->open();
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    log->flush();
+
+    EXPECT_EQ(log->dropped_count(), 0u);
+    EXPECT_EQ(gate_->lines().size(), 1u + 4u * 50u);
+}
+
+TEST_F(BackpressureTest, DropOldest_ManyProducersOnTinyQueue_AccountForEveryMessage) {
+    constexpr int THREADS = 8;
+    constexpr int MESSAGES = 2000;
+
+    logger::QueueOptions options(2);
+    options.policy = logger::OverflowPolicy::DROP_OLDEST;
+    options.report_interval = std::chrono::milliseconds(0);
+    auto log = logger::Logger::create_async_logger(filename_, logger::LogLevel::DEBUG, options);
+
+    // Producers keep evicting each other's slots before they are published; none may spin forever
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; ++t) {
+        producers.emplace_back([&log] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                log->info("message " + std::to_string(i));
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    log->flush();
+
+    std::ifstream file(filename_);
+    uint64_t written = 0;
+    for (std::string line; std::getline(file, line);) {
+        ++written;
+    }
+    EXPECT_EQ(written + log->dropped_count(), static_cast<uint64_t>(THREADS * MESSAGES));
+}
+
+TEST_F(BackpressureTest, DropBelow_OnlyDropsLowLevels) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_OLDEST;
+    options.drop_below = logger::LogLevel::WARNING;
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 4; ++i) {
+        log->debug("filler " + std::to_string(i));
+    }
+    log->debug("dropped debug");
+    log->error("kept error");
+
+    EXPECT_EQ(log->dropped_count(logger::LogLevel::DEBUG), 2u); // the incoming one and one evicted for the error
+    EXPECT_EQ(log->dropped_count(logger::LogLevel::ERROR), 0u);
+
+    gate_->open();
+    log->flush();
+    EXPECT_FALSE(contains(gate_->lines(), "dropped debug"));
+    EXPECT_TRUE(contains(gate_->lines(), "kept error"));
+}
+
+TEST_F(BackpressureTest, Report_WritesSummaryLine) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_NEWEST;
+    options.report_interval = std::chrono::milliseconds(1);
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 7; ++i) {
+        log->debug("message " + std::to_string(i));
+    }
+
+    gate_->open();
+
+    const std::string summary = "[WARNING] Dropped 3 messages due to queue overflow (DEBUG: 3)";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (not contains(gate_->lines(), summary) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_TRUE(contains(gate_->lines(), summary));
+}
+
+TEST_F(BackpressureTest, DropNewest_NeverDropsErrors) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_NEWEST;
+    auto log = create_stalled_logger(options);
+
+    for (int i = 0; i < 4; ++i) {
+        log->debug("filler " + std::to_string(i));
+    }
+
+    // The queue is full, so the error has to wait for the backend instead of being dropped
+    std::thread producer([&] { log->error("kept error"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate_->open();
+    producer.join();
+
+    log->flush();
+    EXPECT_EQ(log->dropped_count(), 0u);
+    EXPECT_TRUE(contains(gate_->lines(), "kept error"));
+}
+
+TEST_F(BackpressureTest, DropOldest_WritesEvictedErrorInsteadOfDropping) {
+    logger::QueueOptions options(4);
+    options.policy = logger::OverflowPolicy::DROP_OLDEST;
+    options.never_drop_level = logger::LogLevel::WARNING;
+    auto log = create_stalled_logger(options);
+
+    // Evicting the warning writes it from the producing thread, which waits for the gated sink like the backend
+    std::thread producer([&] {
+        log->warning("evicted warning");
+        for (int i = 0; i < 4; ++i) {
+            log->info("message " + std::to_string(i));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate_->open();
+    producer.join();
+
+    log->flush();
+    EXPECT_EQ(log->dropped_count(), 0u);
+    EXPECT_TRUE(contains(gate_->lines(), "evicted warning"));
+    EXPECT_TRUE(contains(gate_->lines(), "message 3"));
+}
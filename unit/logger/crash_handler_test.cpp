@@ -0,0 +1,123 @@
+#include <atomic>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <logger/crash_handler.hpp>
+#include <logger/raw_file_sink.hpp>
+
+#include "test_directory.hpp"
+
+class CrashHandlerTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::filesystem::remove(filename_); }
+
+    std::string read_file() {
+        std::ifstream file(filename_);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // Buffers everything: nothing reaches the file before an explicit flush, whatever the level
+    static logger::RawFileSinkOptions buffering_options() {
+        logger::RawFileSinkOptions options;
+        options.flush_policy = logger::FlushPolicy{1 << 20, std::chrono::milliseconds(0), logger::LogLevel::FATAL};
+        return options;
+    }
+
+    TestDirectory directory_;
+    std::string filename_ = directory_.file("test_crash_handler.log");
+};
+
+TEST_F(CrashHandlerTest, FlushBuffers_WritesPublishedBytes) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    const char data[] = "complete line\npartial";
+    std::atomic<size_t> used{14};
+    int handle = logger::CrashHandler::register_buffer(fds[1], data, &used);
+    ASSERT_GE(handle, 0);
+
+    logger::CrashHandler::flush_buffers();
+    logger::CrashHandler::unregister_buffer(handle);
+    logger::CrashHandler::flush_buffers();
+    close(fds[1]);
+
+    char received[64] = {};
+    ssize_t size = read(fds[0], received, sizeof(received));
+    close(fds[0]);
+    EXPECT_EQ(std::string(received, static_cast<size_t>(size)), "complete line\n");
+}
+
+TEST_F(CrashHandlerTest, FlushBuffers_SkipsBytesTheSinkAlreadyWrote) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // As if the signal arrived while the sink's own flush had written the first line
+    const char data[] = "first line\nsecond line\n";
+    std::atomic<size_t> used{sizeof(data) - 1};
+    std::atomic<size_t> written{11};
+    int handle = logger::CrashHandler::register_buffer(fds[1], data, &used, &written);
+    ASSERT_GE(handle, 0);
+
+    logger::CrashHandler::flush_buffers();
+    used.store(0);
+    written.store(0);
+    logger::CrashHandler::flush_buffers();
+    logger::CrashHandler::unregister_buffer(handle);
+    close(fds[1]);
+
+    char received[64] = {};
+    ssize_t size = read(fds[0], received, sizeof(received));
+    close(fds[0]);
+    EXPECT_EQ(std::string(received, static_cast<size_t>(size)), "second line\n");
+}
+
+TEST_F(CrashHandlerTest, RegisterBuffer_RejectsInvalidArguments) {
+    std::atomic<size_t> used{0};
+    EXPECT_EQ(logger::CrashHandler::register_buffer(-1, "x", &used), -1);
+    EXPECT_EQ(logger::CrashHandler::register_buffer(1, nullptr, &used), -1);
+}
+
+TEST_F(CrashHandlerTest, InstallUninstall_RestoresPreviousAction) {
+    ASSERT_TRUE(logger::CrashHandler::install());
+    EXPECT_TRUE(logger::CrashHandler::is_installed());
+
+    logger::CrashHandler::uninstall();
+    EXPECT_FALSE(logger::CrashHandler::is_installed());
+
+    struct sigaction current{};
+    sigaction(SIGTERM, nullptr, &current);
+    EXPECT_EQ(current.sa_handler, SIG_DFL);
+}
+
+TEST_F(CrashHandlerTest, FatalSignal_FlushesSinkBufferAndStillTerminates) {
+    EXPECT_EXIT(
+            {
+                logger::CrashHandler::install();
+                logger::RawFileSink sink(filename_, buffering_options());
+                sink.write("written before the crash");
+                raise(SIGABRT);
+            },
+            ::testing::KilledBySignal(SIGABRT), "Caught SIGABRT");
+
+    EXPECT_EQ(read_file(), "written before the crash\n");
+}
+
+TEST_F(CrashHandlerTest, FatalSignal_WithoutHandlerLosesBuffer) {
+    EXPECT_EXIT(
+            {
+                logger::RawFileSink sink(filename_, buffering_options());
+                sink.write("lost in the buffer");
+                raise(SIGTERM);
+            },
+            ::testing::KilledBySignal(SIGTERM), "");
+
+    EXPECT_EQ(read_file(), "");
+}
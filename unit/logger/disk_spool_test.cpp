@@ -0,0 +1,123 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/disk_spool.hpp>
+
+#include "test_directory.hpp"
+
+class DiskSpoolTest : public ::testing::Test {
+protected:
+    void SetUp() override { base_path_ = directory_.file("spool"); }
+
+    size_t count_segments() {
+        size_t count = 0;
+        for (const auto &entry: std::filesystem::directory_iterator(directory_.path())) {
+            if (entry.path().extension() == ".spool") {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    TestDirectory directory_;
+    std::string base_path_;
+};
+
+TEST_F(DiskSpoolTest, Constructor_InvalidPath) {
+    logger::DiskSpool spool("/invalid/path/spool");
+    EXPECT_FALSE(spool.is_valid());
+    EXPECT_FALSE(spool.append("Message"));
+}
+
+TEST_F(DiskSpoolTest, AppendPeekConsume_Fifo) {
+    logger::DiskSpool spool(base_path_);
+    ASSERT_TRUE(spool.is_valid());
+    EXPECT_TRUE(spool.empty());
+
+    EXPECT_TRUE(spool.append("First"));
+    EXPECT_TRUE(spool.append("Second"));
+    EXPECT_TRUE(spool.append("Third"));
+    EXPECT_FALSE(spool.empty());
+
+    std::vector<std::string> records;
+    ASSERT_EQ(spool.peek(records, 1024), 3u);
+    EXPECT_EQ(records, (std::vector<std::string>{"First", "Second", "Third"}));
+
+    spool.consume(2);
+    ASSERT_EQ(spool.peek(records, 1024), 1u);
+    EXPECT_EQ(records[0], "Third");
+
+    spool.consume(1);
+    EXPECT_TRUE(spool.empty());
+    EXPECT_EQ(spool.peek(records, 1024), 0u);
+}
+
+TEST_F(DiskSpoolTest, Peek_SpansSegmentsInOrder) {
+    logger::DiskSpool spool(base_path_, 1024 * 1024, 64);
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(spool.append("Message " + std::to_string(i)));
+    }
+    EXPECT_GT(count_segments(), 1u);
+
+    std::vector<std::string> received;
+    std::vector<std::string> records;
+    while (spool.peek(records, 4096) > 0) {
+        received.insert(received.end(), records.begin(), records.end());
+        spool.consume(records.size());
+    }
+
+    ASSERT_EQ(received.size(), 50u);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(received[i], "Message " + std::to_string(i));
+    }
+    EXPECT_EQ(count_segments(), 0u);
+}
+
+TEST_F(DiskSpoolTest, Append_SizeCapDropsOldestSegments) {
+    logger::DiskSpool spool(base_path_, 256, 64);
+    for (int i = 0; i < 100; ++i) {
+        spool.append("Message " + std::to_string(i));
+    }
+
+    EXPECT_LE(spool.size_bytes(), 256u);
+    EXPECT_GT(spool.dropped_bytes(), 0u);
+
+    std::vector<std::string> records;
+    std::string last;
+    while (spool.peek(records, 4096) > 0) {
+        last = records.back();
+        spool.consume(records.size());
+    }
+    EXPECT_EQ(last, "Message 99");
+}
+
+TEST_F(DiskSpoolTest, Recovery_ResumesAfterRestart) {
+    {
+        logger::DiskSpool spool(base_path_, 1024 * 1024, 64);
+        for (int i = 0; i < 20; ++i) {
+            spool.append("Message " + std::to_string(i));
+        }
+
+        std::vector<std::string> records;
+        ASSERT_EQ(spool.peek(records, 1), 1u);
+        spool.consume(1);
+    }
+
+    logger::DiskSpool spool(base_path_, 1024 * 1024, 64);
+    ASSERT_TRUE(spool.is_valid());
+    spool.append("Message 20");
+
+    std::vector<std::string> received;
+    std::vector<std::string> records;
+    while (spool.peek(records, 4096) > 0) {
+        received.insert(received.end(), records.begin(), records.end());
+        spool.consume(records.size());
+    }
+
+    ASSERT_EQ(received.size(), 20u);
+    EXPECT_EQ(received.front(), "Message 1");
+    EXPECT_EQ(received.back(), "Message 20");
+}
@@ -8,10 +8,12 @@
 
 #include <logger/file_sink.hpp>
 
+#include "test_directory.hpp"
+
 class FileSinkTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        test_filename_ = "test_file_sink.log";
+        test_filename_ = directory_.file("test_file_sink.log");
         cleanup_file();
     }
 
@@ -40,6 +42,7 @@ protected:
         return content;
     }
 
+    TestDirectory directory_;
     std::string test_filename_;
 };
 
@@ -168,3 +171,92 @@ TEST_F(FileSinkTest, IsValid_AfterConstruction) {
     logger::FileSink invalid_sink("/invalid/path/file.log");
     EXPECT_FALSE(invalid_sink.is_valid());
 }
+
+// write_batch tests
+TEST_F(FileSinkTest, WriteBatch_MultipleMessages) {
+    logger::FileSink sink(test_filename_);
+    ASSERT_TRUE(sink.is_valid());
+
+    std::vector<logger::SinkMessage> batch{{"First message", logger::LogLevel::INFO},
+                                           {"Second message", logger::LogLevel::ERROR},
+                                           {"Third message", logger::LogLevel::DEBUG}};
+    sink.write_batch(batch);
+
+    auto content_opt = read_file_content();
+    ASSERT_TRUE(content_opt.has_value());
+    EXPECT_EQ(content_opt.value(), "First message\nSecond message\nThird message");
+}
+
+TEST_F(FileSinkTest, WriteBatch_EmptyBatch) {
+    logger::FileSink sink(test_filename_);
+    ASSERT_TRUE(sink.is_valid());
+
+    sink.write_batch({});
+
+    auto content_opt = read_file_content();
+    ASSERT_TRUE(content_opt.has_value());
+    EXPECT_EQ(content_opt.value(), "");
+}
+
+// Flush policy tests
+TEST_F(FileSinkTest, FlushPolicy_BuffersUntilThreshold) {
+    logger::FlushPolicy policy;
+    policy.max_buffered_bytes = 1024;
+    logger::FileSink sink(test_filename_, policy);
+    ASSERT_TRUE(sink.is_valid());
+
+    sink.write("Buffered message");
+    EXPECT_EQ(read_file_content().value_or("missing"), "");
+
+    sink.write(std::string(1024, 'x'));
+    EXPECT_NE(read_file_content().value_or("").find("Buffered message"), std::string::npos);
+}
+
+TEST_F(FileSinkTest, FlushPolicy_ExplicitFlush) {
+    logger::FlushPolicy policy;
+    policy.max_buffered_bytes = 1024;
+    logger::FileSink sink(test_filename_, policy);
+
+    sink.write("Buffered message");
+    sink.flush();
+
+    EXPECT_EQ(read_file_content().value_or(""), "Buffered message");
+}
+
+TEST_F(FileSinkTest, FlushPolicy_LevelTriggered) {
+    logger::FlushPolicy policy;
+    policy.max_buffered_bytes = 1024;
+    policy.flush_level = logger::LogLevel::ERROR;
+    logger::FileSink sink(test_filename_, policy);
+
+    sink.write_batch({{"Info message", logger::LogLevel::INFO}});
+    EXPECT_EQ(read_file_content().value_or("missing"), "");
+
+    sink.write_batch({{"Error message", logger::LogLevel::ERROR}});
+    EXPECT_EQ(read_file_content().value_or(""), "Info message\nError message");
+}
+
+TEST_F(FileSinkTest, FlushPolicy_Periodic) {
+    logger::FlushPolicy policy;
+    policy.max_buffered_bytes = 1024;
+    policy.flush_interval = std::chrono::milliseconds(20);
+    logger::FileSink sink(test_filename_, policy);
+
+    sink.write("Buffered message");
+
+    for (int i = 0; i < 100 && read_file_content().value_or("").empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(read_file_content().value_or(""), "Buffered message");
+}
+
+TEST_F(FileSinkTest, FlushPolicy_DestructorFlushes) {
+    {
+        logger::FlushPolicy policy;
+        policy.max_buffered_bytes = 1024;
+        logger::FileSink sink(test_filename_, policy);
+        sink.write("Buffered message");
+    }
+
+    EXPECT_EQ(read_file_content().value_or(""), "Buffered message");
+}
@@ -0,0 +1,43 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <logger/format.hpp>
+#include <logger/log_record.hpp>
+
+class FormatTest : public ::testing::Test {};
+
+TEST_F(FormatTest, NoArguments) { EXPECT_EQ(logger::utility::format("plain text"), "plain text"); }
+
+TEST_F(FormatTest, ReplacesPlaceholdersInOrder) {
+    EXPECT_EQ(logger::utility::format("{} + {} = {}", 1, 2, 3), "1 + 2 = 3");
+}
+
+TEST_F(FormatTest, ArgumentTypes) {
+    std::string str = "string";
+    EXPECT_EQ(logger::utility::format("{} {} {} {} {} {}", str, "literal", 'c', false, -7, 2.5),
+              "string literal c false -7 2.5");
+    EXPECT_EQ(logger::utility::format("level={}", logger::LogLevel::WARNING), "level=WARNING");
+}
+
+TEST_F(FormatTest, EscapedBraces) { EXPECT_EQ(logger::utility::format("{{{}}}", 5), "{5}"); }
+
+TEST_F(FormatTest, MismatchedArgumentCount) {
+    EXPECT_EQ(logger::utility::format("{} and {}", 1), "1 and {}");
+    EXPECT_EQ(logger::utility::format("only {}", 1, 2), "only 1");
+}
+
+TEST_F(FormatTest, EscapedBracesBetweenText) {
+    EXPECT_EQ(logger::utility::format("a {{b}} c {} d}}", 1), "a {b} c 1 d}");
+}
+
+TEST_F(FormatTest, FormatTo_BuildsLogRecordInPlace) {
+    logger::LogRecord record(logger::LogLevel::ERROR);
+    logger::utility::format_to(record, "x={} y={}", 1, "two");
+    EXPECT_EQ(record.message(), "x=1 y=two");
+    EXPECT_EQ(record.level(), logger::LogLevel::ERROR);
+
+    std::string tail(logger::LogRecord::INLINE_CAPACITY, 'z');
+    logger::utility::format_to(record, " {}", tail);
+    EXPECT_EQ(record.message(), "x=1 y=two " + tail);
+}
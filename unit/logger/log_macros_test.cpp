@@ -0,0 +1,86 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+// Strip everything below WARNING in this translation unit
+#undef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 2
+
+#include <logger/log_macros.hpp>
+
+#include "test_directory.hpp"
+
+class LogMacrosTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_filename_ = directory_.file("test_log_macros.log");
+        std::filesystem::remove(test_filename_);
+        logger_ = logger::Logger::create_logger(test_filename_, logger::LogLevel::DEBUG);
+        ASSERT_NE(logger_, nullptr);
+    }
+
+    void TearDown() override {
+        logger_.reset();
+        std::filesystem::remove(test_filename_);
+    }
+
+    std::string make_message(const std::string &text) {
+        ++evaluations_;
+        return text;
+    }
+
+    TestDirectory directory_;
+    std::string test_filename_;
+    std::shared_ptr<logger::Logger> logger_;
+    int evaluations_ = 0;
+};
+
+TEST_F(LogMacrosTest, CompiledOutLevels_DoNotEvaluateArguments) {
+    LOG_DEBUG(logger_, make_message("debug"));
+    LOG_INFO(logger_, make_message("info"));
+
+    EXPECT_EQ(evaluations_, 0);
+}
+
+TEST_F(LogMacrosTest, EnabledLevels_EvaluateArguments) {
+    LOG_WARNING(logger_, make_message("warning"));
+    LOG_ERROR(logger_, make_message("error"));
+    LOG_FATAL(logger_, make_message("fatal"));
+
+    EXPECT_EQ(evaluations_, 3);
+}
+
+TEST_F(LogMacrosTest, RuntimeLevel_SkipsArgumentEvaluation) {
+    logger_->set_default_level(logger::LogLevel::ERROR);
+
+    LOG_WARNING(logger_, make_message("warning"));
+    EXPECT_EQ(evaluations_, 0);
+
+    LOG_ERROR(logger_, make_message("error"));
+    EXPECT_EQ(evaluations_, 1);
+}
+
+TEST_F(LogMacrosTest, IsEnabled_FollowsDefaultLevel) {
+    logger_->set_default_level(logger::LogLevel::WARNING);
+
+    EXPECT_FALSE(logger_->is_enabled(logger::LogLevel::INFO));
+    EXPECT_TRUE(logger_->is_enabled(logger::LogLevel::WARNING));
+    EXPECT_TRUE(logger_->is_enabled(logger::LogLevel::FATAL));
+}
+
+TEST_F(LogMacrosTest, FormatArguments) {
+    LOG_ERROR(logger_, "x={} y={}", 1, "two");
+    LOG_WARNING(logger_, [&] { return make_message("lazy"); });
+    logger_.reset();
+
+    std::ifstream file(test_filename_);
+    std::string first, second;
+    std::getline(file, first);
+    std::getline(file, second);
+
+    EXPECT_NE(first.find("[ERROR] x=1 y=two"), std::string::npos);
+    EXPECT_NE(second.find("[WARNING] lazy"), std::string::npos);
+    EXPECT_EQ(evaluations_, 1);
+}
@@ -0,0 +1,143 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <logger/log_macros.hpp>
+#include <logger/logger.hpp>
+#include <logger/logger_stats.hpp>
+
+#include "test_directory.hpp"
+
+namespace {
+    size_t level_index(logger::LogLevel level) { return static_cast<size_t>(level); }
+
+    class BrokenSink : public logger::ILogSink {
+    public:
+        void write(std::string_view) override {}
+        bool is_valid() const override { return false; }
+    };
+} // namespace
+
+class LoggerStatsTest : public ::testing::Test {
+protected:
+    void TearDown() override { std::filesystem::remove(filename_); }
+
+    std::string read_file() {
+        std::ifstream file(filename_);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    TestDirectory directory_;
+    std::string filename_ = directory_.file("test_logger_stats.log");
+};
+
+TEST(LatencyHistogramTest, Buckets_CoverValuesWithBoundedError) {
+    using logger::LatencyHistogram;
+
+    for (uint64_t value: {0ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, 1ull << 40}) {
+        size_t index = LatencyHistogram::bucket_index(value);
+        uint64_t upper = LatencyHistogram::bucket_upper_bound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / LatencyHistogram::SUB_BUCKET_COUNT) << value;
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucket_upper_bound(index - 1), value) << value;
+        }
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucket_index(~0ull), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, Percentile_FollowsRecordedValues) {
+    logger::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentile(50).count(), 0);
+
+    for (int i = 1; i <= 100; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    histogram.record(std::chrono::nanoseconds(-5)); // clock adjustments must not break the histogram
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.total_count, 101u);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(50).count()), 50'000.0, 50'000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(99).count()), 99'000.0, 99'000.0 / 16);
+    EXPECT_EQ(snapshot.percentile(100), std::chrono::microseconds(100));
+    EXPECT_EQ(snapshot.max(), std::chrono::microseconds(100));
+}
+
+TEST_F(LoggerStatsTest, SyncLogger_CountsLevelsAndSinkBytes) {
+    auto log = logger::Logger::create_logger(filename_, logger::LogLevel::INFO);
+    ASSERT_NE(log, nullptr);
+
+    log->info("12345");
+    log->error("x");
+    log->debug("filtered");
+    log->debug("{}", 42);
+    LOG_DEBUG(log, "filtered by the macro");
+
+    auto stats = log->stats();
+    EXPECT_EQ(stats.accepted[level_index(logger::LogLevel::INFO)], 1u);
+    EXPECT_EQ(stats.accepted[level_index(logger::LogLevel::ERROR)], 1u);
+    EXPECT_EQ(stats.filtered[level_index(logger::LogLevel::DEBUG)], 3u);
+    EXPECT_EQ(logger::LoggerStats::total(stats.dropped), 0u);
+
+    ASSERT_EQ(stats.sinks.size(), 1u);
+    EXPECT_EQ(stats.sinks[0].messages, 2u);
+    EXPECT_EQ(stats.sinks[0].bytes + 2, std::filesystem::file_size(filename_)); // newlines are added by the sink
+    EXPECT_EQ(stats.queue_capacity, 0u);
+    EXPECT_EQ(stats.latency.total_count, 2u);
+}
+
+TEST_F(LoggerStatsTest, AsyncLogger_TracksQueueAndLatency) {
+    auto log = logger::Logger::create_async_logger(filename_, logger::LogLevel::DEBUG, 64);
+    ASSERT_NE(log, nullptr);
+
+    for (int i = 0; i < 500; ++i) {
+        log->debug("Message {}", i);
+    }
+    log->flush();
+
+    auto stats = log->stats();
+    EXPECT_EQ(logger::LoggerStats::total(stats.accepted), 500u);
+    EXPECT_EQ(stats.queue_capacity, 64u);
+    EXPECT_GE(stats.queue_high_water_mark, 1u);
+    EXPECT_LE(stats.queue_high_water_mark, 64u);
+    EXPECT_EQ(stats.latency.total_count, 500u);
+    EXPECT_LE(stats.latency.percentile(50), stats.latency.max());
+}
+
+TEST_F(LoggerStatsTest, InvalidSink_CountsErrors) {
+    auto log = logger::Logger::create_logger(filename_, logger::LogLevel::INFO);
+    ASSERT_NE(log, nullptr);
+    log->add_sink(std::make_unique<BrokenSink>());
+
+    log->info("one");
+    log->info("two");
+
+    auto stats = log->stats();
+    ASSERT_EQ(stats.sinks.size(), 2u);
+    EXPECT_EQ(stats.sinks[0].errors, 0u);
+    EXPECT_EQ(stats.sinks[1].errors, 2u);
+    EXPECT_EQ(stats.sinks[1].messages, 0u);
+}
+
+TEST_F(LoggerStatsTest, StatsInterval_WritesSummaryLine) {
+    auto log = logger::Logger::create_logger(filename_, logger::LogLevel::INFO);
+    ASSERT_NE(log, nullptr);
+    // Long enough that the first write never outlasts it, even on a loaded machine
+    log->set_stats_interval(std::chrono::milliseconds(200));
+
+    log->info("before");
+    EXPECT_EQ(read_file().find("Logger stats:"), std::string::npos);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    log->info("after");
+
+    std::string content = read_file();
+    EXPECT_NE(content.find("[INFO] Logger stats: accepted 2, filtered 0, dropped 0, sink 0: 2 messages"),
+              std::string::npos)
+            << content;
+}
@@ -0,0 +1,271 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/file_sink.hpp>
+#include <logger/logger.hpp>
+
+#include "test_directory.hpp"
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_filename_ = directory_.file("test_logger.log");
+        cleanup_file();
+    }
+
+    void TearDown() override { cleanup_file(); }
+
+    void cleanup_file() {
+        if (std::filesystem::exists(test_filename_)) {
+            std::filesystem::remove(test_filename_);
+        }
+    }
+
+    std::vector<std::string> read_lines() {
+        std::ifstream file(test_filename_);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    TestDirectory directory_;
+    std::string test_filename_;
+};
+
+// Synchronous logger tests
+TEST_F(LoggerTest, SyncLogger_WritesFormattedMessage) {
+    auto logger = logger::Logger::create_logger(test_filename_, logger::LogLevel::INFO);
+    ASSERT_NE(logger, nullptr);
+    EXPECT_FALSE(logger->is_async());
+
+    logger->info("Hello");
+    logger->debug("Filtered");
+
+    auto lines = read_lines();
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("[INFO] Hello"), std::string::npos);
+}
+
+// Asynchronous logger tests
+TEST_F(LoggerTest, AsyncLogger_InvalidFile) {
+    auto logger = logger::Logger::create_async_logger("/invalid/path/file.log");
+    EXPECT_EQ(logger, nullptr);
+}
+
+TEST_F(LoggerTest, AsyncLogger_FlushWritesAllMessages) {
+    auto logger = logger::Logger::create_async_logger(test_filename_, logger::LogLevel::DEBUG);
+    ASSERT_NE(logger, nullptr);
+    EXPECT_TRUE(logger->is_async());
+
+    logger->debug("First");
+    logger->error("Second");
+    logger->flush();
+
+    auto lines = read_lines();
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("[DEBUG] First"), std::string::npos);
+    EXPECT_NE(lines[1].find("[ERROR] Second"), std::string::npos);
+}
+
+TEST_F(LoggerTest, AsyncLogger_DestructorDrainsQueue) {
+    {
+        auto logger = logger::Logger::create_async_logger(test_filename_, logger::LogLevel::INFO, 16);
+        ASSERT_NE(logger, nullptr);
+
+        for (int i = 0; i < 100; ++i) {
+            logger->info("Message " + std::to_string(i));
+        }
+    }
+
+    EXPECT_EQ(read_lines().size(), 100);
+}
+
+TEST_F(LoggerTest, AsyncLogger_ConcurrentProducers) {
+    auto logger = logger::Logger::create_async_logger(test_filename_, logger::LogLevel::INFO, 64);
+    ASSERT_NE(logger, nullptr);
+
+    const int num_threads = 8;
+    const int messages_per_thread = 500;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&logger, t, messages_per_thread]() {
+            for (int i = 0; i < messages_per_thread; ++i) {
+                logger->info("Thread " + std::to_string(t) + " Message " + std::to_string(i));
+            }
+        });
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    logger->flush();
+    EXPECT_EQ(read_lines().size(), static_cast<size_t>(num_threads * messages_per_thread));
+}
+
+// Log record tests
+TEST_F(LoggerTest, LogRecord_InlineAndOverflowMessages) {
+    logger::LogRecord short_record("short", logger::LogLevel::ERROR);
+    EXPECT_EQ(short_record.message(), "short");
+    EXPECT_EQ(short_record.level(), logger::LogLevel::ERROR);
+
+    std::string long_message(logger::LogRecord::INLINE_CAPACITY * 2, 'x');
+    logger::LogRecord long_record(long_message, logger::LogLevel::INFO);
+    EXPECT_EQ(long_record.message(), long_message);
+
+    logger::LogRecord moved = std::move(long_record);
+    EXPECT_EQ(moved.message(), long_message);
+}
+
+TEST_F(LoggerTest, AsyncLogger_TimestampCapturedOnProducer) {
+    auto logger = logger::Logger::create_async_logger(test_filename_, logger::LogLevel::INFO);
+    ASSERT_NE(logger, nullptr);
+
+    auto before = logger::utility::format_timestamp(std::chrono::system_clock::now());
+    logger->info("Captured");
+    logger->flush();
+
+    auto lines = read_lines();
+    ASSERT_EQ(lines.size(), 1);
+    // Timestamps share the same second-resolution prefix unless a second boundary was crossed
+    EXPECT_EQ(lines[0].substr(1, 10), before.substr(0, 10));
+}
+
+// Lazy message construction tests
+TEST_F(LoggerTest, LazyCallable_SkippedWhenFiltered) {
+    auto logger = logger::Logger::create_logger(test_filename_, logger::LogLevel::WARNING);
+    ASSERT_NE(logger, nullptr);
+
+    int calls = 0;
+    logger->debug([&] {
+        ++calls;
+        return std::string("debug");
+    });
+    logger->error([&] {
+        ++calls;
+        return std::string("error");
+    });
+
+    EXPECT_EQ(calls, 1);
+    auto lines = read_lines();
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_NE(lines[0].find("[ERROR] error"), std::string::npos);
+}
+
+TEST_F(LoggerTest, FormatArguments_WrittenWhenEnabled) {
+    auto logger = logger::Logger::create_logger(test_filename_, logger::LogLevel::INFO);
+    ASSERT_NE(logger, nullptr);
+
+    logger->debug("hidden {}", 1);
+    logger->info("x={} y={} ok={}", 42, 1.5, true);
+    logger->warning(std::string("plain {} message"));
+
+    auto lines = read_lines();
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("[INFO] x=42 y=1.5 ok=true"), std::string::npos);
+    EXPECT_NE(lines[1].find("[WARNING] plain {} message"), std::string::npos);
+}
+
+TEST_F(LoggerTest, AddSink_WhileLogging) {
+    auto logger = logger::Logger::create_logger(test_filename_, logger::LogLevel::DEBUG);
+    ASSERT_NE(logger, nullptr);
+
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&logger, &running]() {
+            while (running.load()) {
+                logger->info("Concurrent message");
+                EXPECT_TRUE(logger->is_valid());
+            }
+        });
+    }
+
+    const std::string second_filename = directory_.file("test_logger_second.log");
+    for (int i = 0; i < 20; ++i) {
+        logger->add_sink(std::make_unique<logger::FileSink>(second_filename));
+    }
+    EXPECT_EQ(logger->sink_count(), 21u);
+
+    running.store(false);
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    logger.reset();
+    std::filesystem::remove(second_filename);
+}
+
+TEST_F(LoggerTest, AddSink_PerSinkMinLevel) {
+    auto logger = logger::Logger::create_logger(test_filename_, logger::LogLevel::DEBUG);
+    ASSERT_NE(logger, nullptr);
+
+    const std::string errors_filename = directory_.file("test_logger_errors.log");
+    logger->add_sink(std::make_unique<logger::FileSink>(errors_filename), logger::LogLevel::ERROR);
+
+    logger->debug("Debug message");
+    logger->error("Error message");
+    logger->flush();
+
+    EXPECT_EQ(read_lines().size(), 2u);
+
+    std::ifstream errors_file(errors_filename);
+    std::vector<std::string> error_lines;
+    std::string line;
+    while (std::getline(errors_file, line)) {
+        error_lines.push_back(line);
+    }
+    ASSERT_EQ(error_lines.size(), 1u);
+    EXPECT_NE(error_lines[0].find("Error message"), std::string::npos);
+
+    logger.reset();
+    std::filesystem::remove(errors_filename);
+}
+
+TEST_F(LoggerTest, AsyncLogger_FatalDrainsQueueAndFlushesSinks) {
+    // Records what reached it and whether it was flushed afterwards, without ever flushing on its own
+    class RecordingSink : public logger::ILogSink {
+    public:
+        void write(std::string_view message) override {
+            std::lock_guard<std::mutex> lock(mutex);
+            lines.emplace_back(message);
+            flushed_lines = 0;
+        }
+        void flush() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushed_lines = lines.size();
+        }
+        bool is_valid() const override { return true; }
+
+        std::mutex mutex;
+        std::vector<std::string> lines;
+        size_t flushed_lines = 0;
+    };
+
+    auto logger = logger::Logger::create_async_logger(test_filename_, logger::LogLevel::DEBUG);
+    ASSERT_NE(logger, nullptr);
+    auto sink = std::make_unique<RecordingSink>();
+    auto *recording = sink.get();
+    logger->add_sink(std::move(sink));
+
+    for (int i = 0; i < 1000; ++i) {
+        logger->debug("Message " + std::to_string(i));
+    }
+    logger->fatal("Going down");
+
+    std::lock_guard<std::mutex> lock(recording->mutex);
+    ASSERT_EQ(recording->lines.size(), 1001u);
+    EXPECT_NE(recording->lines.back().find("[FATAL] Going down"), std::string::npos);
+    EXPECT_EQ(recording->flushed_lines, 1001u);
+}
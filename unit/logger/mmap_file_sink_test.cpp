@@ -0,0 +1,145 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/mmap_file_sink.hpp>
+
+#include "test_directory.hpp"
+
+class MmapFileSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        base_filename_ = directory_.file("test_mmap_file_sink.log");
+        cleanup();
+    }
+
+    void TearDown() override { cleanup(); }
+
+    void cleanup() {
+        for (int i = 0; i < 100; ++i) {
+            std::filesystem::remove(segment_path(i));
+        }
+    }
+
+    std::string segment_path(int index) { return base_filename_ + "." + std::to_string(index); }
+
+    std::string read_file(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    TestDirectory directory_;
+    std::string base_filename_;
+};
+
+TEST_F(MmapFileSinkTest, Constructor_InvalidPath) {
+    logger::MmapFileSink sink("/invalid/path/file.log", 4096);
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST_F(MmapFileSinkTest, Write_TrimmedOnClose) {
+    {
+        logger::MmapFileSink sink(base_filename_, 4096);
+        ASSERT_TRUE(sink.is_valid());
+        EXPECT_EQ(sink.current_segment_path(), segment_path(0));
+
+        sink.write("First message");
+        sink.write_batch({{"Second message", logger::LogLevel::INFO}, {"Third message", logger::LogLevel::ERROR}});
+    }
+
+    EXPECT_EQ(read_file(segment_path(0)), "First message\nSecond message\nThird message\n");
+}
+
+TEST_F(MmapFileSinkTest, Write_VisibleBeforeClose) {
+    logger::MmapFileSink sink(base_filename_, 4096);
+    sink.write("Visible message");
+
+    // The mapping is shared with the page cache, so ordinary reads see the line right away
+    std::string content = read_file(segment_path(0));
+    EXPECT_EQ(content.size(), 4096);
+    EXPECT_EQ(content.rfind("Visible message\n", 0), 0);
+}
+
+TEST_F(MmapFileSinkTest, Rollover_ToNextSegment) {
+    {
+        logger::MmapFileSink sink(base_filename_, 64);
+        for (int i = 0; i < 10; ++i) {
+            sink.write("message number " + std::to_string(i));
+        }
+    }
+
+    std::string all;
+    for (int i = 0; std::filesystem::exists(segment_path(i)); ++i) {
+        std::string content = read_file(segment_path(i));
+        EXPECT_LE(content.size(), 64);
+        EXPECT_EQ(content.find('\0'), std::string::npos);
+        all += content;
+    }
+
+    std::string expected;
+    for (int i = 0; i < 10; ++i) {
+        expected += "message number " + std::to_string(i) + "\n";
+    }
+    EXPECT_EQ(all, expected);
+}
+
+TEST_F(MmapFileSinkTest, Rollover_FullSegmentTrimmedWhileSinkIsOpen) {
+    logger::MmapFileSink sink(base_filename_, 64);
+    for (int i = 0; i < 5; ++i) {
+        sink.write("message number " + std::to_string(i));
+    }
+    ASSERT_EQ(sink.current_segment_path(), segment_path(1));
+
+    sink.wait_for_retirements();
+    EXPECT_EQ(read_file(segment_path(0)), "message number 0\nmessage number 1\nmessage number 2\n");
+}
+
+TEST_F(MmapFileSinkTest, Constructor_DoesNotOverwriteExistingSegments) {
+    {
+        logger::MmapFileSink sink(base_filename_, 4096);
+        sink.write("First run");
+    }
+    {
+        logger::MmapFileSink sink(base_filename_, 4096);
+        EXPECT_EQ(sink.current_segment_path(), segment_path(1));
+        sink.write("Second run");
+    }
+
+    EXPECT_EQ(read_file(segment_path(0)), "First run\n");
+    EXPECT_EQ(read_file(segment_path(1)), "Second run\n");
+}
+
+TEST_F(MmapFileSinkTest, Write_ThreadSafetyAcrossRollovers) {
+    const int num_threads = 8;
+    const int messages_per_thread = 500;
+
+    {
+        logger::MmapFileSink sink(base_filename_, 8192);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&sink, t]() {
+                for (int i = 0; i < messages_per_thread; ++i) {
+                    sink.write("Thread " + std::to_string(t) + " Message " + std::to_string(i));
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+    }
+
+    int line_count = 0;
+    for (int i = 0; std::filesystem::exists(segment_path(i)); ++i) {
+        std::ifstream file(segment_path(i));
+        std::string line;
+        while (std::getline(file, line)) {
+            EXPECT_EQ(line.rfind("Thread ", 0), 0);
+            line_count++;
+        }
+    }
+    EXPECT_EQ(line_count, num_threads * messages_per_thread);
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/protocol.hpp>
+
+namespace protocol = logger::protocol;
+
+TEST(ProtocolTest, EncodeDecode_RoundTrip) {
+    auto timestamp = std::chrono::system_clock::now();
+    std::string frame = protocol::encode_frame("Test message", logger::LogLevel::WARNING, timestamp);
+    EXPECT_EQ(frame.size(), protocol::HEADER_SIZE + 12);
+
+    protocol::FrameDecoder decoder;
+    decoder.feed(frame.data(), frame.size());
+
+    protocol::Frame decoded;
+    ASSERT_TRUE(decoder.next(decoded));
+    EXPECT_EQ(decoded.payload, "Test message");
+    EXPECT_EQ(decoded.level, logger::LogLevel::WARNING);
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::microseconds>(decoded.timestamp - timestamp).count(), 0);
+    EXPECT_FALSE(decoder.next(decoded));
+    EXPECT_EQ(decoder.buffered_bytes(), 0u);
+}
+
+TEST(ProtocolTest, Decoder_ReassemblesSplitFrames) {
+    std::string stream;
+    for (int i = 0; i < 10; ++i) {
+        stream += protocol::encode_frame("message " + std::to_string(i), logger::LogLevel::INFO,
+                                         std::chrono::system_clock::now());
+    }
+
+    // Feed one byte at a time: frames must neither merge nor split
+    protocol::FrameDecoder decoder;
+    std::vector<std::string> payloads;
+    protocol::Frame frame;
+    for (char c: stream) {
+        decoder.feed(&c, 1);
+        while (decoder.next(frame)) {
+            payloads.emplace_back(frame.payload);
+        }
+    }
+
+    ASSERT_EQ(payloads.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(payloads[i], "message " + std::to_string(i));
+    }
+}
+
+TEST(ProtocolTest, Decoder_MultipleFramesInOneRead) {
+    std::string stream = protocol::encode_frame("first", logger::LogLevel::DEBUG, {}) +
+                         protocol::encode_frame("", logger::LogLevel::INFO, {}) +
+                         protocol::encode_frame("third", logger::LogLevel::FATAL, {});
+
+    protocol::FrameDecoder decoder;
+    decoder.feed(stream.data(), stream.size() - 2);
+
+    protocol::Frame frame;
+    ASSERT_TRUE(decoder.next(frame));
+    EXPECT_EQ(frame.payload, "first");
+    ASSERT_TRUE(decoder.next(frame));
+    EXPECT_EQ(frame.payload, "");
+    EXPECT_FALSE(decoder.next(frame));
+
+    decoder.feed(stream.data() + stream.size() - 2, 2);
+    ASSERT_TRUE(decoder.next(frame));
+    EXPECT_EQ(frame.payload, "third");
+    EXPECT_EQ(frame.level, logger::LogLevel::FATAL);
+}
+
+TEST(ProtocolTest, Decoder_RejectsCorruptHeader) {
+    std::string garbage(protocol::HEADER_SIZE, 'x');
+
+    protocol::FrameDecoder decoder;
+    decoder.feed(garbage.data(), garbage.size());
+
+    protocol::Frame frame;
+    EXPECT_FALSE(decoder.next(frame));
+    EXPECT_TRUE(decoder.has_error());
+
+    decoder.reset();
+    EXPECT_FALSE(decoder.has_error());
+}
+
+TEST(ProtocolTest, DatagramHeader_RoundTrip) {
+    char header[protocol::DATAGRAM_HEADER_SIZE];
+    protocol::encode_datagram_header(header, 0xFFFFFFF0u);
+
+    uint32_t sequence = 0;
+    ASSERT_TRUE(protocol::decode_datagram_header(std::string_view(header, sizeof(header)), sequence));
+    EXPECT_EQ(sequence, 0xFFFFFFF0u);
+
+    EXPECT_FALSE(protocol::decode_datagram_header(std::string_view(header, 4), sequence));
+    // A stream frame is not a datagram
+    std::string frame = protocol::encode_frame("text", logger::LogLevel::INFO, {});
+    EXPECT_FALSE(protocol::decode_datagram_header(frame, sequence));
+}
+
+TEST(ProtocolTest, DecodeFrame_SingleRecord) {
+    std::string frame = protocol::encode_frame("record", logger::LogLevel::ERROR, {});
+
+    protocol::Frame decoded;
+    ASSERT_TRUE(protocol::decode_frame(frame, decoded));
+    EXPECT_EQ(decoded.payload, "record");
+    EXPECT_EQ(decoded.level, logger::LogLevel::ERROR);
+
+    EXPECT_FALSE(protocol::decode_frame(std::string_view(frame).substr(0, frame.size() - 1), decoded));
+}
@@ -0,0 +1,321 @@
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <malloc.h>
+
+#include <logger/log_macros.hpp>
+#include <logger/logger.hpp>
+#include <logger/rate_limiter.hpp>
+
+#include "test_directory.hpp"
+
+namespace {
+    class CollectingSink : public logger::ILogSink {
+    public:
+        void write(std::string_view message) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lines_.emplace_back(message);
+        }
+
+        bool is_valid() const override { return true; }
+
+        std::vector<std::string> lines() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lines_;
+        }
+
+        size_t count(const std::string &text) {
+            size_t result = 0;
+            for (const auto &line: lines()) {
+                result += line.find(text) != std::string::npos ? 1 : 0;
+            }
+            return result;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<std::string> lines_;
+    };
+
+    size_t level_index(logger::LogLevel level) { return static_cast<size_t>(level); }
+} // namespace
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        log_ = logger::Logger::create_logger(filename_, logger::LogLevel::DEBUG);
+        ASSERT_NE(log_, nullptr);
+        log_->clear_sinks();
+
+        auto sink = std::make_unique<CollectingSink>();
+        sink_ = sink.get();
+        log_->add_sink(std::move(sink));
+    }
+
+    void TearDown() override {
+        log_.reset();
+        std::filesystem::remove(filename_);
+    }
+
+    TestDirectory directory_;
+    std::string filename_ = directory_.file("test_rate_limiter.log");
+    std::shared_ptr<logger::Logger> log_;
+    CollectingSink *sink_ = nullptr;
+};
+
+TEST_F(RateLimiterTest, PerLevelBucket_AllowsBurstThenSuppresses) {
+    logger::RateLimitOptions options;
+    options.per_level[level_index(logger::LogLevel::DEBUG)] = logger::RateLimit{1, 5};
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 100; ++i) {
+        log_->debug("storm");
+        log_->info("steady");
+    }
+
+    EXPECT_EQ(sink_->count("storm"), 5u);
+    EXPECT_EQ(sink_->count("steady"), 100u);
+    EXPECT_EQ(log_->stats().suppressed[level_index(logger::LogLevel::DEBUG)], 95u);
+}
+
+TEST_F(RateLimiterTest, PerLevelBucket_Refills) {
+    logger::RateLimitOptions options;
+    options.per_level[level_index(logger::LogLevel::INFO)] = logger::RateLimit{100, 1};
+    log_->set_rate_limits(options);
+
+    log_->info("first");
+    log_->info("suppressed");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    log_->info("after refill");
+
+    EXPECT_EQ(sink_->count("first"), 1u);
+    EXPECT_EQ(sink_->count("suppressed"), 0u);
+    EXPECT_EQ(sink_->count("after refill"), 1u);
+}
+
+TEST_F(RateLimiterTest, EveryNth_KeepsFirstOfEachGroup) {
+    logger::RateLimitOptions options;
+    options.every_nth[level_index(logger::LogLevel::INFO)] = 10;
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 100; ++i) {
+        log_->info("message {}", i);
+    }
+
+    auto lines = sink_->lines();
+    ASSERT_EQ(lines.size(), 10u);
+    EXPECT_NE(lines[0].find("message 0"), std::string::npos);
+    EXPECT_NE(lines[1].find("message 10"), std::string::npos);
+}
+
+TEST_F(RateLimiterTest, Probability_KeepsRoughlyThatShare) {
+    logger::RateLimitOptions options;
+    options.sample_probability[level_index(logger::LogLevel::DEBUG)] = 0.25;
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 10000; ++i) {
+        log_->debug("sampled");
+    }
+
+    EXPECT_NEAR(static_cast<double>(sink_->count("sampled")), 2500.0, 300.0);
+}
+
+TEST_F(RateLimiterTest, PerCallSite_LimitsEachStatementSeparately) {
+    logger::RateLimitOptions options;
+    options.per_call_site = logger::RateLimit{1, 2};
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 50; ++i) {
+        LOG_INFO(log_, "first site");
+        LOG_INFO(log_, "second site {}", i);
+        log_->info("no call site");
+    }
+
+    EXPECT_EQ(sink_->count("first site"), 2u);
+    EXPECT_EQ(sink_->count("second site"), 2u);
+    EXPECT_EQ(sink_->count("no call site"), 50u);
+}
+
+TEST_F(RateLimiterTest, ExemptLevel_NeverLimited) {
+    logger::RateLimitOptions options;
+    options.every_nth.fill(1000);
+    options.exempt_level = logger::LogLevel::ERROR;
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 10; ++i) {
+        log_->error("error");
+        log_->warning("warning");
+    }
+
+    EXPECT_EQ(sink_->count("error"), 10u);
+    EXPECT_EQ(sink_->count("warning"), 1u);
+}
+
+TEST_F(RateLimiterTest, ClearRateLimits_LetsEverythingThrough) {
+    logger::RateLimitOptions options;
+    options.every_nth.fill(1000);
+    log_->set_rate_limits(options);
+    log_->clear_rate_limits();
+
+    for (int i = 0; i < 10; ++i) {
+        log_->debug("message");
+    }
+    EXPECT_EQ(sink_->count("message"), 10u);
+}
+
+TEST_F(RateLimiterTest, Summary_ReportsSuppressedCountsAndCallSite) {
+    logger::RateLimitOptions options;
+    options.per_call_site = logger::RateLimit{1, 1};
+    // Long enough that the loop never straddles two summaries, even on a loaded machine
+    options.report_interval = std::chrono::milliseconds(200);
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 20; ++i) {
+        LOG_DEBUG(log_, "noisy");
+    }
+    int noisy_line = __LINE__ - 2;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    log_->info("trigger");
+
+    std::string expected = "[WARNING] Suppressed 19 messages by rate limits and sampling (DEBUG: 19), "
+                           "busiest call site rate_limiter_test.cpp:" +
+                           std::to_string(noisy_line) + " (19)";
+    EXPECT_EQ(sink_->count(expected), 1u);
+}
+
+TEST_F(RateLimiterTest, PerCallSite_LevelRejectionKeepsSiteToken) {
+    logger::RateLimitOptions options;
+    options.per_level[level_index(logger::LogLevel::INFO)] = logger::RateLimit{20, 1};
+    options.per_call_site = logger::RateLimit{0.001, 2};
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 4; ++i) {
+        LOG_INFO(log_, "site {}", i);
+        if (i % 2 == 1) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        }
+    }
+
+    // 0 passes, 1 is rejected by the level bucket, 2 uses the site's second token, 3 finds the site bucket empty
+    EXPECT_EQ(sink_->count("site 0"), 1u);
+    EXPECT_EQ(sink_->count("site 1"), 0u);
+    EXPECT_EQ(sink_->count("site 2"), 1u);
+    EXPECT_EQ(sink_->count("site 3"), 0u);
+}
+
+TEST_F(RateLimiterTest, PerCallSite_EachLoggerHasItsOwnBudget) {
+    auto other = logger::Logger::create_logger(directory_.file("other.log"), logger::LogLevel::DEBUG);
+    ASSERT_NE(other, nullptr);
+    other->clear_sinks();
+    auto other_sink = std::make_unique<CollectingSink>();
+    CollectingSink *other_lines = other_sink.get();
+    other->add_sink(std::move(other_sink));
+
+    logger::RateLimitOptions options;
+    options.per_call_site = logger::RateLimit{0.001, 3};
+    log_->set_rate_limits(options);
+    other->set_rate_limits(options);
+
+    auto log_from_one_site = [](const std::shared_ptr<logger::Logger> &target) { LOG_INFO(target, "shared site"); };
+    for (int i = 0; i < 10; ++i) {
+        log_from_one_site(log_);
+        log_from_one_site(other);
+    }
+
+    EXPECT_EQ(sink_->count("shared site"), 3u);
+    EXPECT_EQ(other_lines->count("shared site"), 3u);
+}
+
+TEST_F(RateLimiterTest, Summary_WrittenWhenEverythingIsSuppressed) {
+    logger::RateLimitOptions options;
+    options.every_nth[level_index(logger::LogLevel::DEBUG)] = 1000;
+    options.report_interval = std::chrono::milliseconds(200);
+    log_->set_rate_limits(options);
+
+    log_->debug("kept");
+    for (int i = 0; i < 20; ++i) {
+        log_->debug("suppressed");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    log_->debug("suppressed");
+
+    EXPECT_EQ(sink_->count("Suppressed 21 messages by rate limits and sampling (DEBUG: 21)"), 1u);
+}
+
+TEST_F(RateLimiterTest, Summary_FlushedWhenLimitsAreReplaced) {
+    logger::RateLimitOptions options;
+    options.every_nth[level_index(logger::LogLevel::DEBUG)] = 1000;
+    options.report_interval = std::chrono::hours(1);
+    log_->set_rate_limits(options);
+
+    for (int i = 0; i < 10; ++i) {
+        log_->debug("suppressed");
+    }
+    log_->clear_rate_limits();
+
+    EXPECT_EQ(sink_->count("Suppressed 9 messages by rate limits and sampling (DEBUG: 9)"), 1u);
+}
+
+TEST_F(RateLimiterTest, SetRateLimits_ReplacedLimitersAreFreedAndKeepTheirCounts) {
+    constexpr int ROUNDS = 2000;
+
+    // No sink and no summaries, so nothing but the limiters themselves could pile up
+    log_->clear_sinks();
+    logger::RateLimitOptions options;
+    options.every_nth[level_index(logger::LogLevel::DEBUG)] = 1000;
+    options.report_interval = std::chrono::milliseconds(0);
+
+    log_->set_rate_limits(options);
+    size_t allocated_before = mallinfo2().uordblks;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        log_->set_rate_limits(options);
+        for (int i = 0; i < 10; ++i) {
+            log_->debug("suppressed");
+        }
+    }
+
+    // Every limiter holds a table of call-site slots, so keeping the replaced ones would take tens of megabytes
+    size_t allocated_after = mallinfo2().uordblks;
+    EXPECT_LT(allocated_after, allocated_before + 1024 * 1024);
+
+    auto stats = log_->stats();
+    EXPECT_EQ(stats.suppressed[level_index(logger::LogLevel::DEBUG)], 9u * ROUNDS);
+
+    log_->clear_rate_limits();
+    EXPECT_EQ(log_->stats().suppressed[level_index(logger::LogLevel::DEBUG)], 9u * ROUNDS);
+}
+
+TEST(RateLimiterAsyncTest, Summary_FlushedWhenLimitsAreReplaced) {
+    TestDirectory directory;
+    auto log = logger::Logger::create_async_logger(directory.file("test_rate_limiter_async.log"),
+                                                   logger::LogLevel::DEBUG);
+    ASSERT_NE(log, nullptr);
+    log->clear_sinks();
+    auto sink = std::make_unique<CollectingSink>();
+    CollectingSink *lines = sink.get();
+    log->add_sink(std::move(sink));
+
+    logger::RateLimitOptions options;
+    options.every_nth[level_index(logger::LogLevel::DEBUG)] = 1000;
+    options.report_interval = std::chrono::hours(1);
+    log->set_rate_limits(options);
+    for (int i = 0; i < 10; ++i) {
+        log->debug("suppressed");
+    }
+    log->set_rate_limits(logger::RateLimitOptions());
+    log->flush();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (lines->count("Suppressed 9 messages") == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(lines->count("Suppressed 9 messages by rate limits and sampling (DEBUG: 9)"), 1u);
+}
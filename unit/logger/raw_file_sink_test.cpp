@@ -0,0 +1,137 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/raw_file_sink.hpp>
+
+#include "test_directory.hpp"
+
+class RawFileSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_filename_ = directory_.file("test_raw_file_sink.log");
+        std::filesystem::remove(test_filename_);
+    }
+
+    void TearDown() override { std::filesystem::remove(test_filename_); }
+
+    std::string read_file() {
+        std::ifstream file(test_filename_, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    TestDirectory directory_;
+    std::string test_filename_;
+};
+
+TEST_F(RawFileSinkTest, Constructor_ValidFile) {
+    logger::RawFileSink sink(test_filename_);
+    EXPECT_TRUE(sink.is_valid());
+}
+
+TEST_F(RawFileSinkTest, Constructor_InvalidPath) {
+    logger::RawFileSink sink("/invalid/path/file.log");
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST_F(RawFileSinkTest, Write_BufferedUntilFlush) {
+    logger::RawFileSink sink(test_filename_);
+
+    sink.write("First message");
+    sink.write("Second message");
+    EXPECT_EQ(read_file(), "");
+
+    sink.flush();
+    EXPECT_EQ(read_file(), "First message\nSecond message\n");
+}
+
+TEST_F(RawFileSinkTest, WriteBatch_LevelTriggeredFlush) {
+    logger::RawFileSink sink(test_filename_);
+
+    sink.write_batch({{"Info message", logger::LogLevel::INFO}});
+    EXPECT_EQ(read_file(), "");
+
+    sink.write_batch({{"Fatal message", logger::LogLevel::FATAL}});
+    EXPECT_EQ(read_file(), "Info message\nFatal message\n");
+}
+
+TEST_F(RawFileSinkTest, DropPageCache_KeepsContentIntact) {
+    logger::RawFileSinkOptions options;
+    options.drop_page_cache = true;
+    logger::RawFileSink sink(test_filename_, options);
+
+    std::string expected;
+    for (int i = 0; i < 5; ++i) {
+        std::string line(5000, static_cast<char>('a' + i));
+        sink.write(line);
+        sink.flush();
+        expected += line + "\n";
+    }
+
+    EXPECT_TRUE(sink.is_valid());
+    EXPECT_EQ(read_file(), expected);
+}
+
+TEST_F(RawFileSinkTest, Write_MessageLargerThanBuffer) {
+    logger::RawFileSinkOptions options;
+    options.buffer_size = 4096;
+    logger::RawFileSink sink(test_filename_, options);
+
+    std::string large(10000, 'x');
+    sink.write("small");
+    sink.write(large);
+    sink.flush();
+
+    EXPECT_EQ(read_file(), "small\n" + large + "\n");
+}
+
+TEST_F(RawFileSinkTest, Destructor_FlushesAndAppends) {
+    {
+        logger::RawFileSink sink(test_filename_);
+        sink.write("First run");
+    }
+    {
+        logger::RawFileSinkOptions options;
+        options.preallocate_bytes = 1024 * 1024;
+        logger::RawFileSink sink(test_filename_, options);
+        sink.write("Second run");
+    }
+
+    EXPECT_EQ(read_file(), "First run\nSecond run\n");
+}
+
+TEST_F(RawFileSinkTest, Write_ThreadSafety) {
+    const int num_threads = 8;
+    const int messages_per_thread = 1000;
+
+    {
+        logger::RawFileSinkOptions options;
+        options.buffer_size = 8192;
+        logger::RawFileSink sink(test_filename_, options);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&sink, t]() {
+                for (int i = 0; i < messages_per_thread; ++i) {
+                    sink.write("Thread " + std::to_string(t) + " Message " + std::to_string(i));
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+    }
+
+    std::ifstream file(test_filename_);
+    int line_count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        EXPECT_EQ(line.rfind("Thread ", 0), 0);
+        line_count++;
+    }
+    EXPECT_EQ(line_count, num_threads * messages_per_thread);
+}
@@ -0,0 +1,84 @@
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/ring_buffer.hpp>
+
+class RingBufferTest : public ::testing::Test {};
+
+TEST_F(RingBufferTest, Capacity_RoundedUpToPowerOfTwo) {
+    logger::RingBuffer<int> buffer(100);
+    EXPECT_EQ(buffer.capacity(), 128);
+}
+
+TEST_F(RingBufferTest, PushPop_PreservesOrder) {
+    logger::RingBuffer<int> buffer(8);
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(buffer.try_push(i));
+    }
+    EXPECT_EQ(buffer.size(), 5);
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(buffer.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(RingBufferTest, Pop_EmptyBuffer) {
+    logger::RingBuffer<int> buffer(4);
+    int value = 0;
+    EXPECT_FALSE(buffer.try_pop(value));
+}
+
+TEST_F(RingBufferTest, Push_FullBuffer) {
+    logger::RingBuffer<int> buffer(4);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.try_push(i));
+    }
+    EXPECT_FALSE(buffer.try_push(4));
+
+    int value = 0;
+    ASSERT_TRUE(buffer.try_pop(value));
+    EXPECT_TRUE(buffer.try_push(4));
+}
+
+TEST_F(RingBufferTest, ConcurrentProducers_NoLostItems) {
+    const int num_threads = 8;
+    const int items_per_thread = 10000;
+    logger::RingBuffer<int> buffer(1024);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < num_threads; ++t) {
+        producers.emplace_back([&buffer, t, items_per_thread]() {
+            for (int i = 0; i < items_per_thread; ++i) {
+                int item = t * items_per_thread + i;
+                while (not buffer.try_push(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::set<int> received;
+    int value = 0;
+    while (received.size() < static_cast<size_t>(num_threads * items_per_thread)) {
+        if (buffer.try_pop(value)) {
+            received.insert(value);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto &producer: producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(received.size(), static_cast<size_t>(num_threads * items_per_thread));
+    EXPECT_TRUE(buffer.empty());
+}
@@ -0,0 +1,182 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/logger.hpp>
+#include <logger/rotating_file_sink.hpp>
+
+#include "test_directory.hpp"
+
+class RotatingFileSinkTest : public ::testing::Test {
+protected:
+    // Rotated archives and pending files land next to the log, so the whole directory goes with the test
+    void SetUp() override { test_filename_ = directory_.file("test_rotating_file_sink.log"); }
+
+    std::string read_file(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    size_t count_pending_files() {
+        size_t count = 0;
+        std::string prefix = std::filesystem::path(test_filename_).filename().string() + ".pending.";
+        for (const auto &entry: std::filesystem::directory_iterator(directory_.path())) {
+            if (entry.path().filename().string().rfind(prefix, 0) == 0) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    TestDirectory directory_;
+    std::string test_filename_;
+};
+
+TEST_F(RotatingFileSinkTest, Constructor_ValidFile) {
+    logger::RotatingFileSink sink(test_filename_, logger::RotationPolicy{});
+    EXPECT_TRUE(sink.is_valid());
+}
+
+TEST_F(RotatingFileSinkTest, Constructor_InvalidPath) {
+    logger::RotatingFileSink sink("/invalid/path/file.log", logger::RotationPolicy{});
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST_F(RotatingFileSinkTest, Write_NoLimitsNeverRotates) {
+    {
+        logger::RotatingFileSink sink(test_filename_, logger::RotationPolicy{});
+        for (int i = 0; i < 100; ++i) {
+            sink.write("Message");
+        }
+    }
+
+    EXPECT_EQ(read_file(test_filename_).size(), 100u * 8);
+    EXPECT_FALSE(std::filesystem::exists(test_filename_ + ".1"));
+}
+
+TEST_F(RotatingFileSinkTest, Write_RotatesBySize) {
+    logger::RotationPolicy policy;
+    policy.max_bytes = 20;
+
+    logger::RotatingFileSink sink(test_filename_, policy);
+    sink.write("First message");
+    sink.write("Second message");
+    sink.write("Third message");
+    sink.wait_for_rotations();
+
+    EXPECT_EQ(read_file(test_filename_), "Third message\n");
+    EXPECT_EQ(read_file(test_filename_ + ".1"), "Second message\n");
+    EXPECT_EQ(read_file(test_filename_ + ".2"), "First message\n");
+}
+
+TEST_F(RotatingFileSinkTest, Write_RotatesByAge) {
+    logger::RotationPolicy policy;
+    policy.max_age = std::chrono::seconds(1);
+
+    logger::RotatingFileSink sink(test_filename_, policy);
+    sink.write("Old message");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    sink.write("New message");
+    sink.wait_for_rotations();
+
+    EXPECT_EQ(read_file(test_filename_), "New message\n");
+    EXPECT_EQ(read_file(test_filename_ + ".1"), "Old message\n");
+}
+
+TEST_F(RotatingFileSinkTest, Write_KeepsAtMostMaxFiles) {
+    logger::RotationPolicy policy;
+    policy.max_bytes = 1;
+    policy.max_files = 2;
+
+    logger::RotatingFileSink sink(test_filename_, policy);
+    for (int i = 0; i < 6; ++i) {
+        sink.write("Message " + std::to_string(i));
+    }
+    sink.wait_for_rotations();
+
+    EXPECT_EQ(read_file(test_filename_), "Message 5\n");
+    EXPECT_EQ(read_file(test_filename_ + ".1"), "Message 4\n");
+    EXPECT_EQ(read_file(test_filename_ + ".2"), "Message 3\n");
+    EXPECT_FALSE(std::filesystem::exists(test_filename_ + ".3"));
+}
+
+TEST_F(RotatingFileSinkTest, Destructor_RemovesUnusedPendingFile) {
+    {
+        logger::RotatingFileSink sink(test_filename_, logger::RotationPolicy{});
+        sink.write("Message");
+    }
+
+    EXPECT_EQ(count_pending_files(), 0u);
+}
+
+TEST_F(RotatingFileSinkTest, Constructor_RecoversPendingFilesOfCrashedRun) {
+    // A run that crashed after switching to its pending file but before finalizing the rotation
+    std::ofstream(test_filename_) << "oldest\n";
+    std::ofstream(test_filename_ + ".pending.0") << "newer\n";
+    std::ofstream(test_filename_ + ".pending.1") << "newest\n";
+    std::ofstream(test_filename_ + ".pending.2").flush();
+
+    {
+        logger::RotatingFileSink sink(test_filename_, logger::RotationPolicy{});
+        ASSERT_TRUE(sink.is_valid());
+        sink.write("Appended");
+    }
+
+    EXPECT_EQ(read_file(test_filename_), "newest\nAppended\n");
+    EXPECT_EQ(read_file(test_filename_ + ".1"), "newer\n");
+    EXPECT_EQ(read_file(test_filename_ + ".2"), "oldest\n");
+    EXPECT_EQ(count_pending_files(), 0u);
+}
+
+TEST_F(RotatingFileSinkTest, MultithreadedWrites_NoMessagesLost) {
+    logger::RotationPolicy policy;
+    policy.max_bytes = 16384;
+
+    const int num_threads = 4;
+    const int messages_per_thread = 500;
+    {
+        logger::RotatingFileSink sink(test_filename_, policy);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&sink]() {
+                for (int i = 0; i < messages_per_thread; ++i) {
+                    sink.write_batch({{"Concurrent message", logger::LogLevel::INFO}});
+                }
+            });
+        }
+        for (auto &thread: threads) {
+            thread.join();
+        }
+        sink.wait_for_rotations();
+    }
+
+    size_t total_lines = 0;
+    for (const auto &path: {test_filename_, test_filename_ + ".1", test_filename_ + ".2", test_filename_ + ".3",
+                            test_filename_ + ".4", test_filename_ + ".5"}) {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            EXPECT_EQ(line, "Concurrent message");
+            ++total_lines;
+        }
+    }
+    EXPECT_EQ(total_lines, static_cast<size_t>(num_threads * messages_per_thread));
+}
+
+TEST_F(RotatingFileSinkTest, CreateLogger_WithRotationPolicy) {
+    logger::RotationPolicy policy;
+    policy.max_bytes = 64;
+
+    auto logger = logger::Logger::create_logger(test_filename_, policy);
+    ASSERT_NE(logger, nullptr);
+
+    logger->info("Message one");
+    logger->info("Message two");
+    logger.reset();
+
+    EXPECT_TRUE(std::filesystem::exists(test_filename_ + ".1"));
+}
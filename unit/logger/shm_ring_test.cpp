@@ -0,0 +1,287 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <logger/logger.hpp>
+#include <logger/protocol.hpp>
+#include <logger/shm_ring.hpp>
+#include <logger/shm_sink.hpp>
+
+namespace {
+    std::string unique_ring_name() {
+        static std::atomic<int> counter{0};
+        return "/logger_test_" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    }
+
+    bool write_string(logger::ShmRing &ring, const std::string &text) {
+        std::string_view part = text;
+        return ring.try_write(&part, 1);
+    }
+
+    std::vector<std::string> read_all(logger::ShmRing &ring) {
+        std::vector<std::string> records;
+        ring.read([&](std::string_view record) { records.emplace_back(record); });
+        return records;
+    }
+} // namespace
+
+TEST(ShmRingTest, Open_FailsWithoutReader) { EXPECT_EQ(logger::ShmRing::open(unique_ring_name()), nullptr); }
+
+TEST(ShmRingTest, ObjectName_StripsPrefixAndAddsSlash) {
+    EXPECT_TRUE(logger::ShmRing::is_shm_address("shm:logger"));
+    EXPECT_FALSE(logger::ShmRing::is_shm_address("unix:/tmp/logger.sock"));
+    EXPECT_EQ(logger::ShmRing::object_name("shm:logger"), "/logger");
+    EXPECT_EQ(logger::ShmRing::object_name("/logger"), "/logger");
+}
+
+TEST(ShmRingTest, WriteRead_AcrossMappings) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+    auto writer = logger::ShmRing::open(name);
+    ASSERT_NE(writer, nullptr);
+
+    std::string_view parts[] = {"Hello, ", "shared ", "memory"};
+    EXPECT_TRUE(writer->try_write(parts, 3));
+    EXPECT_TRUE(write_string(*writer, "Second"));
+
+    EXPECT_FALSE(reader->empty());
+    auto records = read_all(*reader);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0], "Hello, shared memory");
+    EXPECT_EQ(records[1], "Second");
+    EXPECT_TRUE(reader->empty());
+}
+
+TEST(ShmRingTest, Write_WrapsAroundManyTimes) {
+    std::string name = unique_ring_name();
+    auto ring = logger::ShmRing::create(name, 4096);
+    ASSERT_NE(ring, nullptr);
+
+    // Odd sizes make records straddle the end of the data area, which needs padding records
+    for (int i = 0; i < 2000; ++i) {
+        std::string text(static_cast<size_t>(i % 300), static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(write_string(*ring, text));
+
+        auto records = read_all(*ring);
+        ASSERT_EQ(records.size(), 1u);
+        EXPECT_EQ(records[0], text);
+    }
+}
+
+TEST(ShmRingTest, Write_DropsWhenFull) {
+    std::string name = unique_ring_name();
+    auto ring = logger::ShmRing::create(name, 4096);
+    ASSERT_NE(ring, nullptr);
+
+    std::string text(100, 'x');
+    int written = 0;
+    while (write_string(*ring, text)) {
+        ++written;
+    }
+
+    EXPECT_GT(written, 0);
+    EXPECT_EQ(ring->dropped_count(), 1u);
+    EXPECT_EQ(read_all(*ring).size(), static_cast<size_t>(written));
+
+    // Consumed space is reusable
+    EXPECT_TRUE(write_string(*ring, text));
+}
+
+TEST(ShmRingTest, MultipleProducers_NoRecordLostOrTorn) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name, 64 * 1024);
+    ASSERT_NE(reader, nullptr);
+
+    const int num_threads = 4;
+    const int per_thread = 5000;
+    std::atomic<int> failed{0};
+    std::vector<std::thread> producers;
+
+    for (int t = 0; t < num_threads; ++t) {
+        producers.emplace_back([&, t] {
+            auto writer = logger::ShmRing::open(name);
+            if (not writer) {
+                ++failed;
+                return;
+            }
+
+            for (int i = 0; i < per_thread; ++i) {
+                std::string text = "T" + std::to_string(t) + "-" + std::to_string(i);
+                // Back off instead of dropping, so every record must arrive
+                while (not write_string(*writer, text)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::set<std::string> received;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (received.size() < static_cast<size_t>(num_threads * per_thread) &&
+           std::chrono::steady_clock::now() < deadline) {
+        if (reader->read([&](std::string_view record) { received.emplace(record); }) == 0) {
+            reader->wait(std::chrono::milliseconds(10));
+        }
+    }
+
+    for (auto &producer: producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(failed.load(), 0);
+    EXPECT_EQ(received.size(), static_cast<size_t>(num_threads * per_thread));
+    EXPECT_TRUE(received.count("T3-4999"));
+}
+
+TEST(ShmRingTest, Wait_WakesOnCommit) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+
+    EXPECT_FALSE(reader->wait(std::chrono::milliseconds(10)));
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        auto writer = logger::ShmRing::open(name);
+        write_string(*writer, "wake up");
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(reader->wait(std::chrono::seconds(5)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(4));
+    producer.join();
+
+    EXPECT_EQ(read_all(*reader), std::vector<std::string>{"wake up"});
+}
+
+TEST(ShmRingTest, Interrupt_EndsWaitAtOnce) {
+    auto reader = logger::ShmRing::create(unique_ring_name());
+    ASSERT_NE(reader, nullptr);
+
+    std::thread stopper([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        reader->interrupt();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(reader->wait(std::chrono::seconds(5)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(4));
+    stopper.join();
+
+    // Later waits do not park either
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(reader->wait(std::chrono::seconds(5)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(4));
+}
+
+TEST(ShmSinkTest, WriteBatch_SendsFrames) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+
+    logger::ShmSink sink("shm:" + name.substr(1));
+    ASSERT_TRUE(sink.is_valid());
+
+    auto now = std::chrono::system_clock::now();
+    sink.write_batch({logger::SinkMessage{"first", logger::LogLevel::WARNING, now},
+                      logger::SinkMessage{"second", logger::LogLevel::FATAL, now}});
+
+    std::vector<logger::protocol::Frame> frames;
+    std::vector<std::string> payloads;
+    reader->read([&](std::string_view record) {
+        logger::protocol::Frame frame;
+        ASSERT_TRUE(logger::protocol::decode_frame(record, frame));
+        frames.push_back(frame);
+        payloads.emplace_back(frame.payload);
+    });
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(payloads[0], "first");
+    EXPECT_EQ(frames[0].level, logger::LogLevel::WARNING);
+    EXPECT_EQ(payloads[1], "second");
+    EXPECT_EQ(frames[1].level, logger::LogLevel::FATAL);
+}
+
+TEST(ShmSinkTest, IsValid_FalseWithoutOrAfterReader) {
+    std::string name = unique_ring_name();
+    EXPECT_FALSE(logger::ShmSink(name).is_valid());
+
+    logger::ShmSinkOptions options;
+    options.reconnect = false;
+    auto reader = logger::ShmRing::create(name);
+    logger::ShmSink sink(name, options);
+    EXPECT_TRUE(sink.is_valid());
+
+    reader.reset();
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST(ShmSinkTest, Reconnect_ReopensAfterReaderRestarts) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+
+    logger::ShmSinkOptions options;
+    options.initial_backoff = std::chrono::milliseconds(10);
+    logger::ShmSink sink(name, options);
+    sink.write("before");
+    EXPECT_EQ(read_all(*reader).size(), 1u);
+
+    reader.reset();
+    sink.write("lost");
+    EXPECT_TRUE(sink.is_valid());
+    EXPECT_EQ(sink.dropped_count(), 1u);
+
+    reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sink.write("after");
+
+    auto records = read_all(*reader);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("after"), std::string::npos);
+}
+
+TEST(ShmSinkTest, Reconnect_MovesToReplacingReader) {
+    std::string name = unique_ring_name();
+    auto old_reader = logger::ShmRing::create(name);
+    ASSERT_NE(old_reader, nullptr);
+    logger::ShmSink sink(name);
+
+    // A collector that restarts without its predecessor shutting down cleanly takes the name over
+    auto new_reader = logger::ShmRing::create(name);
+    ASSERT_NE(new_reader, nullptr);
+    EXPECT_TRUE(old_reader->is_closed());
+
+    sink.write("moved");
+    auto records = read_all(*new_reader);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("moved"), std::string::npos);
+    EXPECT_TRUE(read_all(*old_reader).empty());
+
+    // Destroying the replaced ring must not unlink the new one
+    old_reader.reset();
+    EXPECT_NE(logger::ShmRing::open(name), nullptr);
+}
+
+TEST(ShmSinkTest, CreateLogger_WithShmAddress) {
+    std::string name = unique_ring_name();
+    auto reader = logger::ShmRing::create(name);
+    ASSERT_NE(reader, nullptr);
+
+    auto log = logger::Logger::create_logger("shm:" + name.substr(1), 0, logger::LogLevel::INFO);
+    ASSERT_NE(log, nullptr);
+    log->error("through shared memory");
+
+    auto records = read_all(*reader);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("through shared memory"), std::string::npos);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <sys/un.h>
+
+#include <logger/socket_endpoint.hpp>
+
+TEST(SocketEndpointTest, Parse_Tcp) {
+    auto endpoint = logger::SocketEndpoint::parse("127.0.0.1", 9000);
+
+    EXPECT_EQ(endpoint.transport, logger::SocketEndpoint::Transport::TCP);
+    EXPECT_EQ(endpoint.address, "127.0.0.1");
+    EXPECT_EQ(endpoint.port, 9000);
+    EXPECT_FALSE(endpoint.is_unix());
+    EXPECT_EQ(endpoint.address_family(), AF_INET);
+    EXPECT_EQ(endpoint.to_string(), "127.0.0.1:9000");
+}
+
+TEST(SocketEndpointTest, Parse_UnixStream) {
+    auto endpoint = logger::SocketEndpoint::parse("unix:/tmp/logger.sock", 9000);
+
+    EXPECT_EQ(endpoint.transport, logger::SocketEndpoint::Transport::UNIX_STREAM);
+    EXPECT_EQ(endpoint.address, "/tmp/logger.sock");
+    EXPECT_EQ(endpoint.port, 0);
+    EXPECT_EQ(endpoint.address_family(), AF_UNIX);
+    EXPECT_EQ(endpoint.socket_type(), SOCK_STREAM);
+    EXPECT_EQ(endpoint.to_string(), "unix:/tmp/logger.sock");
+}
+
+TEST(SocketEndpointTest, Parse_UnixSeqpacket) {
+    auto endpoint = logger::SocketEndpoint::parse("seqpacket:/tmp/logger.sock");
+
+    EXPECT_EQ(endpoint.transport, logger::SocketEndpoint::Transport::UNIX_SEQPACKET);
+    EXPECT_EQ(endpoint.socket_type(), SOCK_SEQPACKET);
+    EXPECT_TRUE(logger::SocketEndpoint::is_unix_address("seqpacket:/tmp/logger.sock"));
+    EXPECT_FALSE(logger::SocketEndpoint::is_unix_address("127.0.0.1"));
+}
+
+TEST(SocketEndpointTest, Parse_Udp) {
+    auto endpoint = logger::SocketEndpoint::parse("udp:127.0.0.1", 9000);
+
+    EXPECT_EQ(endpoint.transport, logger::SocketEndpoint::Transport::UDP);
+    EXPECT_EQ(endpoint.address, "127.0.0.1");
+    EXPECT_EQ(endpoint.port, 9000);
+    EXPECT_TRUE(endpoint.is_udp());
+    EXPECT_FALSE(endpoint.is_unix());
+    EXPECT_FALSE(logger::SocketEndpoint::is_unix_address("udp:127.0.0.1"));
+    EXPECT_EQ(endpoint.address_family(), AF_INET);
+    EXPECT_EQ(endpoint.socket_type(), SOCK_DGRAM);
+    EXPECT_EQ(endpoint.to_string(), "udp:127.0.0.1:9000");
+}
+
+TEST(SocketEndpointTest, ToSockaddr_RejectsMalformedAddresses) {
+    sockaddr_storage storage;
+    socklen_t length;
+
+    EXPECT_FALSE(logger::SocketEndpoint::parse("not an address", 9000).to_sockaddr(storage, length));
+    EXPECT_FALSE(logger::SocketEndpoint::parse("unix:").to_sockaddr(storage, length));
+    EXPECT_FALSE(logger::SocketEndpoint::parse("unix:" + std::string(200, 'x')).to_sockaddr(storage, length));
+    EXPECT_TRUE(logger::SocketEndpoint::parse("unix:/tmp/logger.sock").to_sockaddr(storage, length));
+}
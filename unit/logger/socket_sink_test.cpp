@@ -0,0 +1,527 @@
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <logger/protocol.hpp>
+#include <logger/socket_sink.hpp>
+
+#include "test_directory.hpp"
+
+class SocketSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_NE(listen_fd_, -1);
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = 0;
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+        ASSERT_EQ(bind(listen_fd_, (sockaddr *) &addr, sizeof(addr)), 0);
+        ASSERT_EQ(listen(listen_fd_, 1), 0);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, (sockaddr *) &addr, &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    void TearDown() override {
+        if (client_fd_ != -1) {
+            close(client_fd_);
+        }
+        close(listen_fd_);
+    }
+
+    // Listens on the same port again, e.g. to simulate a restarted collector
+    void reopen_listener() {
+        close(listen_fd_);
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT_NE(listen_fd_, -1);
+
+        int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port_);
+        inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+        ASSERT_EQ(bind(listen_fd_, (sockaddr *) &addr, sizeof(addr)), 0);
+        ASSERT_EQ(listen(listen_fd_, 1), 0);
+    }
+
+    void accept_client() {
+        decoder_.reset();
+        client_fd_ = accept(listen_fd_, nullptr, nullptr);
+        ASSERT_NE(client_fd_, -1);
+    }
+
+    // Decodes frames until `expected_size` payload bytes arrived or nothing arrives for a while;
+    // returns the concatenated payloads
+    std::string receive(size_t expected_size) {
+        std::string data;
+        char buffer[4096];
+        while (data.size() < expected_size) {
+            logger::protocol::Frame frame;
+            if (decoder_.next(frame)) {
+                data.append(frame.payload);
+                levels_.push_back(frame.level);
+                continue;
+            }
+
+            pollfd pfd{client_fd_, POLLIN, 0};
+            if (poll(&pfd, 1, 1000) <= 0) {
+                break;
+            }
+            ssize_t n = recv(client_fd_, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            decoder_.feed(buffer, static_cast<size_t>(n));
+        }
+        return data;
+    }
+
+    int listen_fd_ = -1;
+    int client_fd_ = -1;
+    int port_ = 0;
+    logger::protocol::FrameDecoder decoder_;
+    std::vector<logger::LogLevel> levels_;
+};
+
+TEST_F(SocketSinkTest, Constructor_NoServer) {
+    close(listen_fd_);
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+
+    logger::SocketSink sink("127.0.0.1", port_);
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST_F(SocketSinkTest, Write_SingleMessage) {
+    logger::SocketSink sink("127.0.0.1", port_);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    sink.write("Test message");
+
+    EXPECT_EQ(receive(12), "Test message");
+}
+
+TEST_F(SocketSinkTest, WriteBatch_ManyMessages) {
+    logger::SocketSink sink("127.0.0.1", port_);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    // More messages than fit in a single sendmsg() call
+    std::vector<std::string> texts;
+    std::string expected;
+    for (int i = 0; i < 3000; ++i) {
+        texts.push_back("message " + std::to_string(i) + ";");
+        expected += texts.back();
+    }
+
+    std::vector<logger::SinkMessage> batch;
+    for (const auto &text: texts) {
+        batch.push_back(logger::SinkMessage{text, logger::LogLevel::INFO});
+    }
+    sink.write_batch(batch);
+
+    EXPECT_EQ(receive(expected.size()), expected);
+    EXPECT_EQ(levels_.size(), texts.size());
+    EXPECT_TRUE(sink.is_valid());
+}
+
+TEST_F(SocketSinkTest, WriteBatch_FramesCarryLevelAndTimestamp) {
+    logger::SocketSink sink("127.0.0.1", port_);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    auto timestamp = std::chrono::system_clock::now();
+    sink.write_batch({{"", logger::LogLevel::DEBUG, timestamp}, {"Error message", logger::LogLevel::ERROR, timestamp}});
+
+    char buffer[4096];
+    ssize_t n = 0;
+    std::vector<logger::protocol::Frame> frames;
+    logger::protocol::Frame frame;
+    while (frames.size() < 2 && (n = recv(client_fd_, buffer, sizeof(buffer), 0)) > 0) {
+        decoder_.feed(buffer, static_cast<size_t>(n));
+        while (decoder_.next(frame)) {
+            frames.push_back(frame);
+        }
+    }
+
+    ASSERT_EQ(frames.size(), 2u);
+    EXPECT_EQ(frames[0].level, logger::LogLevel::DEBUG);
+    EXPECT_TRUE(frames[0].payload.empty());
+    EXPECT_EQ(frames[1].level, logger::LogLevel::ERROR);
+    EXPECT_EQ(frames[1].payload, "Error message");
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::microseconds>(frames[1].timestamp - timestamp).count(), 0);
+}
+
+TEST_F(SocketSinkTest, Write_OversizedMessageTruncatedToProtocolLimit) {
+    logger::SocketSink sink("127.0.0.1", port_);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    // More than the socket buffers hold, so it is written while the test reads
+    std::thread writer([&sink] {
+        std::string huge(logger::protocol::MAX_PAYLOAD_SIZE + 100, 'x');
+        sink.write(huge);
+        sink.write("after");
+    });
+    std::string received = receive(logger::protocol::MAX_PAYLOAD_SIZE + 5);
+    writer.join();
+
+    EXPECT_FALSE(decoder_.has_error());
+    EXPECT_EQ(received.size(), logger::protocol::MAX_PAYLOAD_SIZE + 5);
+    EXPECT_EQ(received.substr(received.size() - 5), "after");
+    EXPECT_EQ(sink.truncated_count(), 1u);
+    EXPECT_TRUE(sink.is_connected());
+}
+
+TEST_F(SocketSinkTest, Reconnect_ReplaysSpilledMessages) {
+    logger::SocketSinkOptions options;
+    options.initial_backoff = std::chrono::milliseconds(10);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    // The first sends after the peer closed may still succeed, keep writing until the loss is noticed
+    close(client_fd_);
+    client_fd_ = -1;
+    size_t dropped_before = sink.dropped_count();
+    for (int i = 0; i < 10; ++i) {
+        sink.write("probe;");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(sink.is_valid());
+
+    sink.write("first;");
+    sink.write("second;");
+
+    // The listener stayed open, so the sink reconnects into its backlog
+    accept_client();
+    std::string data;
+    while (data.find("second;") == std::string::npos) {
+        std::string chunk = receive(1);
+        if (chunk.empty()) {
+            break;
+        }
+        data += chunk;
+    }
+    EXPECT_NE(data.find("first;second;"), std::string::npos);
+    EXPECT_EQ(sink.dropped_count(), dropped_before);
+    EXPECT_TRUE(sink.is_connected());
+}
+
+TEST_F(SocketSinkTest, Spill_DropsOldestBeyondBudget) {
+    logger::SocketSinkOptions options;
+    options.initial_backoff = std::chrono::milliseconds(1000);
+    options.max_spill_bytes = 2 * (logger::protocol::HEADER_SIZE + 8);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    close(client_fd_);
+    client_fd_ = -1;
+    close(listen_fd_);
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+
+    for (int i = 0; i < 100 && sink.is_connected(); ++i) {
+        sink.write("probe;");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_FALSE(sink.is_connected());
+
+    size_t dropped_before = sink.dropped_count();
+    for (int i = 0; i < 10; ++i) {
+        sink.write("12345678");
+    }
+    EXPECT_GE(sink.dropped_count() - dropped_before, 8u);
+}
+
+TEST_F(SocketSinkTest, NoReconnect_InvalidAfterDisconnect) {
+    logger::SocketSinkOptions options;
+    options.reconnect = false;
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    close(client_fd_);
+    client_fd_ = -1;
+    for (int i = 0; i < 100 && sink.is_valid(); ++i) {
+        sink.write("probe;");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(sink.is_valid());
+}
+
+TEST_F(SocketSinkTest, Spool_DrainsInOrderAfterOutage) {
+    TestDirectory directory;
+    const std::string spool_path = directory.file("test_socket_sink_spool");
+
+    logger::SocketSinkOptions options;
+    options.initial_backoff = std::chrono::milliseconds(10);
+    options.max_backoff = std::chrono::milliseconds(10);
+    options.max_spill_bytes = 16;
+    options.spool_path = spool_path;
+
+    {
+        logger::SocketSink sink("127.0.0.1", port_, options);
+        ASSERT_TRUE(sink.is_valid());
+        accept_client();
+
+        close(client_fd_);
+        client_fd_ = -1;
+        close(listen_fd_);
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+
+        for (int i = 0; i < 100 && sink.is_connected(); ++i) {
+            sink.write("probe;");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_FALSE(sink.is_connected());
+
+        std::string expected;
+        for (int i = 0; i < 100; ++i) {
+            std::string message = "message " + std::to_string(i) + ";";
+            sink.write(message);
+            expected += message;
+        }
+        EXPECT_GT(sink.spooled_bytes(), 0u);
+        EXPECT_EQ(sink.dropped_count(), 0u);
+
+        reopen_listener();
+        accept_client();
+
+        std::string data;
+        while (data.find("message 99;") == std::string::npos) {
+            std::string chunk = receive(1);
+            if (chunk.empty()) {
+                break;
+            }
+            data += chunk;
+        }
+        EXPECT_NE(data.find(expected), std::string::npos);
+    }
+}
+
+TEST_F(SocketSinkTest, Coalesce_SendsAfterDeadline) {
+    logger::SocketSinkOptions options;
+    options.coalesce = true;
+    options.coalesce_delay = std::chrono::milliseconds(50);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    sink.write("first;");
+    sink.write("second;");
+
+    // Nothing leaves before the deadline
+    pollfd pfd{client_fd_, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 20), 0);
+
+    EXPECT_EQ(receive(13), "first;second;");
+}
+
+TEST_F(SocketSinkTest, Coalesce_HighLevelFlushesImmediately) {
+    logger::SocketSinkOptions options;
+    options.coalesce = true;
+    options.coalesce_delay = std::chrono::seconds(10);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    sink.write_batch({{"info;", logger::LogLevel::INFO, {}}});
+    sink.write_batch({{"error;", logger::LogLevel::ERROR, {}}});
+
+    EXPECT_EQ(receive(11), "info;error;");
+    EXPECT_EQ(levels_, (std::vector<logger::LogLevel>{logger::LogLevel::INFO, logger::LogLevel::ERROR}));
+}
+
+TEST_F(SocketSinkTest, Coalesce_FlushesOnSizeThresholdAndExplicitFlush) {
+    logger::SocketSinkOptions options;
+    options.coalesce = true;
+    options.coalesce_bytes = 4 * (logger::protocol::HEADER_SIZE + 8);
+    options.coalesce_delay = std::chrono::seconds(10);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    for (int i = 0; i < 4; ++i) {
+        sink.write("message" + std::to_string(i));
+    }
+    EXPECT_EQ(receive(32), "message0message1message2message3");
+
+    sink.write("tail");
+    sink.flush();
+    EXPECT_EQ(receive(4), "tail");
+}
+
+TEST_F(SocketSinkTest, Coalesce_KeepsOrderAcrossReconnect) {
+    logger::SocketSinkOptions options;
+    options.coalesce = true;
+    options.coalesce_delay = std::chrono::milliseconds(20);
+    options.initial_backoff = std::chrono::milliseconds(10);
+    options.max_backoff = std::chrono::milliseconds(10);
+
+    logger::SocketSink sink("127.0.0.1", port_, options);
+    ASSERT_TRUE(sink.is_valid());
+    accept_client();
+
+    // The collector goes away while frames wait in the send buffer; keep writing until the sink notices and
+    // a little beyond, so frames end up both in the send buffer and in the spill
+    close(client_fd_);
+    client_fd_ = -1;
+    close(listen_fd_);
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    int next = 0;
+    for (int i = 0; i < 200 && sink.is_connected(); ++i) {
+        sink.write("m" + std::to_string(next++) + ";");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_FALSE(sink.is_connected());
+    for (int i = 0; i < 20; ++i) {
+        sink.write("m" + std::to_string(next++) + ";");
+    }
+    std::string last = "m" + std::to_string(next - 1) + ";";
+
+    // Whatever went into the dead connection is lost, but what arrives must keep the order it was written in
+    reopen_listener();
+    accept_client();
+    std::string data;
+    while (data.find(last) == std::string::npos) {
+        std::string chunk = receive(1);
+        if (chunk.empty()) {
+            break;
+        }
+        data += chunk;
+    }
+    ASSERT_NE(data.find(last), std::string::npos);
+
+    int previous = -1;
+    for (size_t start = 0; start < data.size();) {
+        size_t end = data.find(';', start);
+        ASSERT_NE(end, std::string::npos);
+        int index = std::stoi(data.substr(start + 1, end - start - 1));
+        EXPECT_GT(index, previous) << data;
+        previous = index;
+        start = end + 1;
+    }
+}
+
+namespace {
+    // Listens on a Unix domain socket of the given type and returns the listening descriptor
+    int listen_unix(const std::string &path, int type) {
+        unlink(path.c_str());
+
+        int fd = socket(AF_UNIX, type, 0);
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        if (fd == -1 || bind(fd, (sockaddr *) &addr, sizeof(addr)) != 0 || listen(fd, 1) != 0) {
+            return -1;
+        }
+        return fd;
+    }
+
+    std::vector<std::string> receive_payloads(int fd, size_t count) {
+        std::vector<std::string> payloads;
+        logger::protocol::FrameDecoder decoder;
+        std::vector<char> buffer(logger::SocketEndpoint::MAX_SEQPACKET_SIZE);
+
+        while (payloads.size() < count) {
+            pollfd pfd{fd, POLLIN, 0};
+            if (poll(&pfd, 1, 1000) <= 0) {
+                break;
+            }
+            ssize_t n = recv(fd, buffer.data(), buffer.size(), 0);
+            if (n <= 0) {
+                break;
+            }
+
+            decoder.feed(buffer.data(), static_cast<size_t>(n));
+            logger::protocol::Frame frame;
+            while (decoder.next(frame)) {
+                payloads.emplace_back(frame.payload);
+            }
+        }
+        return payloads;
+    }
+} // namespace
+
+TEST(UnixSocketSinkTest, UnixStream_DeliversFrames) {
+    TestDirectory directory;
+    const std::string path = directory.file("stream.sock");
+    int listen_fd = listen_unix(path, SOCK_STREAM);
+    ASSERT_NE(listen_fd, -1);
+
+    logger::SocketSink sink("unix:" + path, 0);
+    ASSERT_TRUE(sink.is_valid());
+    int client_fd = accept(listen_fd, nullptr, nullptr);
+    ASSERT_NE(client_fd, -1);
+
+    sink.write("First message");
+    sink.write("Second message");
+
+    EXPECT_EQ(receive_payloads(client_fd, 2), (std::vector<std::string>{"First message", "Second message"}));
+
+    close(client_fd);
+    close(listen_fd);
+    unlink(path.c_str());
+}
+
+TEST(UnixSocketSinkTest, Seqpacket_LargeBatchSplitIntoRecords) {
+    TestDirectory directory;
+    const std::string path = directory.file("seqpacket.sock");
+    int listen_fd = listen_unix(path, SOCK_SEQPACKET);
+    ASSERT_NE(listen_fd, -1);
+
+    logger::SocketSink sink(logger::SocketEndpoint::parse("seqpacket:" + path));
+    ASSERT_TRUE(sink.is_valid());
+    int client_fd = accept(listen_fd, nullptr, nullptr);
+    ASSERT_NE(client_fd, -1);
+
+    // Several times larger than one record
+    std::vector<std::string> texts;
+    std::vector<logger::SinkMessage> batch;
+    for (int i = 0; i < 2000; ++i) {
+        texts.push_back("message " + std::to_string(i) + std::string(100, '.'));
+    }
+    for (const auto &text: texts) {
+        batch.push_back(logger::SinkMessage{text, logger::LogLevel::INFO});
+    }
+
+    std::thread writer([&sink, &batch]() { sink.write_batch(batch); });
+    auto payloads = receive_payloads(client_fd, texts.size());
+    writer.join();
+
+    EXPECT_EQ(payloads, texts);
+    EXPECT_TRUE(sink.is_valid());
+
+    close(client_fd);
+    close(listen_fd);
+    unlink(path.c_str());
+}
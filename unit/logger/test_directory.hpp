@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+// A directory of its own for the running test under the gtest temporary directory, removed with everything in it
+// on destruction. ctest runs every test as a separate process, in parallel with -j, so files must never be shared.
+class TestDirectory {
+public:
+    TestDirectory() {
+        const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::string name = std::string(info->test_suite_name()) + "." + info->name() + "." + std::to_string(getpid());
+        for (auto &c: name) {
+            c = c == '/' ? '_' : c; // parameterized test names
+        }
+
+        path_ = std::filesystem::path(::testing::TempDir()) / name;
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    ~TestDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    TestDirectory(const TestDirectory &) = delete;
+    TestDirectory &operator=(const TestDirectory &) = delete;
+
+    [[nodiscard]] const std::filesystem::path &path() const { return path_; }
+    [[nodiscard]] std::string file(const std::string &name) const { return (path_ / name).string(); }
+
+private:
+    std::filesystem::path path_;
+};
@@ -0,0 +1,164 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <logger/logger.hpp>
+#include <logger/protocol.hpp>
+#include <logger/udp_sink.hpp>
+
+namespace protocol = logger::protocol;
+
+class UdpSinkTest : public ::testing::Test {
+protected:
+    struct Datagram {
+        uint32_t first_sequence = 0;
+        std::vector<std::string> payloads;
+        size_t size = 0;
+    };
+
+    void SetUp() override {
+        receiver_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_NE(receiver_fd_, -1);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        ASSERT_EQ(bind(receiver_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+
+        socklen_t length = sizeof(address);
+        getsockname(receiver_fd_, reinterpret_cast<sockaddr *>(&address), &length);
+        port_ = ntohs(address.sin_port);
+    }
+
+    void TearDown() override { close(receiver_fd_); }
+
+    // Reads datagrams until none arrives for a while
+    std::vector<Datagram> receive() {
+        std::vector<Datagram> datagrams;
+        std::vector<char> buffer(protocol::MAX_DATAGRAM_SIZE);
+
+        pollfd poll_fd{receiver_fd_, POLLIN, 0};
+        while (poll(&poll_fd, 1, 200) > 0) {
+            ssize_t size = recv(receiver_fd_, buffer.data(), buffer.size(), 0);
+            if (size <= 0) {
+                break;
+            }
+
+            Datagram datagram;
+            datagram.size = static_cast<size_t>(size);
+            std::string_view rest(buffer.data(), datagram.size);
+            EXPECT_TRUE(protocol::decode_datagram_header(rest, datagram.first_sequence));
+            rest.remove_prefix(protocol::DATAGRAM_HEADER_SIZE);
+
+            protocol::Frame frame;
+            while (not rest.empty() && protocol::decode_frame(rest, frame)) {
+                datagram.payloads.emplace_back(frame.payload);
+                rest.remove_prefix(protocol::HEADER_SIZE + frame.payload.size());
+            }
+            EXPECT_TRUE(rest.empty());
+
+            datagrams.push_back(std::move(datagram));
+        }
+
+        return datagrams;
+    }
+
+    static std::vector<logger::SinkMessage> make_batch(const std::vector<std::string> &texts) {
+        std::vector<logger::SinkMessage> batch;
+        for (const auto &text: texts) {
+            batch.push_back(logger::SinkMessage{text, logger::LogLevel::DEBUG, std::chrono::system_clock::now()});
+        }
+        return batch;
+    }
+
+    int receiver_fd_ = -1;
+    int port_ = 0;
+};
+
+TEST_F(UdpSinkTest, WriteBatch_PacksFramesIntoOneDatagram) {
+    logger::UdpSink sink("127.0.0.1", port_);
+    ASSERT_TRUE(sink.is_valid());
+
+    std::vector<std::string> texts = {"first", "second", "third"};
+    sink.write_batch(make_batch(texts));
+
+    auto datagrams = receive();
+    ASSERT_EQ(datagrams.size(), 1u);
+    EXPECT_EQ(datagrams[0].first_sequence, 0u);
+    EXPECT_EQ(datagrams[0].payloads, texts);
+    EXPECT_EQ(sink.sent_datagrams(), 1u);
+    EXPECT_EQ(sink.dropped_count(), 0u);
+}
+
+TEST_F(UdpSinkTest, WriteBatch_RespectsDatagramBudget) {
+    logger::UdpSinkOptions options;
+    options.max_datagram_size = 512;
+    logger::UdpSink sink("udp:127.0.0.1", port_, options);
+
+    std::vector<std::string> texts;
+    for (int i = 0; i < 40; ++i) {
+        texts.push_back("Message number " + std::to_string(i) + std::string(50, '.'));
+    }
+    sink.write_batch(make_batch(texts));
+
+    auto datagrams = receive();
+    ASSERT_GT(datagrams.size(), 1u);
+
+    // Every datagram stays within the budget and starts with the sequence number of its first message
+    std::vector<std::string> received;
+    for (const auto &datagram: datagrams) {
+        EXPECT_LE(datagram.size, options.max_datagram_size);
+        EXPECT_EQ(datagram.first_sequence, received.size());
+        received.insert(received.end(), datagram.payloads.begin(), datagram.payloads.end());
+    }
+    EXPECT_EQ(received, texts);
+}
+
+TEST_F(UdpSinkTest, Write_OversizedFrameTravelsAlone) {
+    logger::UdpSink sink("127.0.0.1", port_);
+
+    std::string large(4000, 'x');
+    sink.write_batch(make_batch({"small", large, "after"}));
+
+    auto datagrams = receive();
+    ASSERT_EQ(datagrams.size(), 3u);
+    EXPECT_EQ(datagrams[1].payloads, std::vector<std::string>{large});
+    EXPECT_EQ(datagrams[2].first_sequence, 2u);
+}
+
+TEST_F(UdpSinkTest, SequenceContinuesAcrossCalls) {
+    logger::UdpSink sink("127.0.0.1", port_);
+
+    sink.write_batch(make_batch({"a", "b"}));
+    sink.write("c");
+
+    auto datagrams = receive();
+    ASSERT_EQ(datagrams.size(), 2u);
+    EXPECT_EQ(datagrams[1].first_sequence, 2u);
+}
+
+TEST_F(UdpSinkTest, Invalid_ForNonUdpEndpoint) {
+    EXPECT_FALSE(logger::UdpSink("unix:/tmp/logger.sock", 0).is_valid());
+    EXPECT_FALSE(logger::UdpSink("not an address", port_).is_valid());
+}
+
+TEST_F(UdpSinkTest, CreateLogger_WithUdpAddress) {
+    auto log = logger::Logger::create_logger("udp:127.0.0.1", port_, logger::LogLevel::DEBUG);
+    ASSERT_NE(log, nullptr);
+
+    log->debug("over udp");
+
+    auto datagrams = receive();
+    ASSERT_EQ(datagrams.size(), 1u);
+    ASSERT_EQ(datagrams[0].payloads.size(), 1u);
+    EXPECT_NE(datagrams[0].payloads[0].find("over udp"), std::string::npos);
+}
@@ -91,3 +91,82 @@ TEST_F(UtilityTest, FormatMessage_SpecialCharacters) {
     EXPECT_TRUE(formatted.find("[ERROR]") != std::string::npos);
     EXPECT_TRUE(formatted.find("Message with\nnewlines\tand\ttabs") != std::string::npos);
 }
+
+TEST_F(UtilityTest, FormatMessage_ExplicitTimestamp) {
+    auto timestamp = std::chrono::system_clock::now();
+    std::string formatted = logger::utility::format_message("Deferred", logger::LogLevel::WARNING, timestamp);
+
+    EXPECT_EQ(formatted, "[" + logger::utility::format_timestamp(timestamp) + "] [WARNING] Deferred");
+}
+
+// Tests for the allocation-free formatter
+TEST_F(UtilityTest, FormatMessageTo_CallerBuffer) {
+    char buffer[128];
+    auto timestamp = std::chrono::system_clock::now();
+
+    std::string_view formatted = logger::utility::format_message_to(buffer, sizeof(buffer), "Test message",
+                                                                    logger::LogLevel::INFO, timestamp);
+
+    EXPECT_EQ(formatted.data(), buffer);
+    EXPECT_EQ(formatted, logger::utility::format_message("Test message", logger::LogLevel::INFO, timestamp));
+}
+
+TEST_F(UtilityTest, FormatMessageTo_TruncatesLongMessage) {
+    char buffer[48];
+    std::string_view formatted = logger::utility::format_message_to(
+            buffer, sizeof(buffer), std::string(100, 'x'), logger::LogLevel::DEBUG, std::chrono::system_clock::now());
+
+    EXPECT_EQ(formatted.size(), sizeof(buffer));
+    EXPECT_NE(formatted.find("[DEBUG] xxx"), std::string_view::npos);
+}
+
+TEST_F(UtilityTest, FormatMessageTo_BufferTooSmallForHeader) {
+    char buffer[8];
+    EXPECT_TRUE(logger::utility::format_message_to(buffer, sizeof(buffer), "msg", logger::LogLevel::INFO,
+                                                   std::chrono::system_clock::now())
+                        .empty());
+}
+
+TEST_F(UtilityTest, FormatMessageView_LongMessage) {
+    std::string message(logger::utility::FORMAT_BUFFER_SIZE * 2, 'y');
+    std::string_view formatted = logger::utility::format_message_view(message, logger::LogLevel::ERROR);
+
+    std::regex format_regex(R"(\[\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}\.\d{6}\] \[ERROR\] y+)");
+    EXPECT_TRUE(std::regex_match(std::string(formatted), format_regex));
+    EXPECT_EQ(formatted.size(), message.size() + logger::utility::TIMESTAMP_LENGTH + 11);
+}
+
+// Tests for the cached timestamp prefix
+TEST_F(UtilityTest, FormatTimestamp_SameSecondDifferentSubSecond) {
+    auto base = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+
+    std::string first = logger::utility::format_timestamp(base + std::chrono::milliseconds(5));
+    std::string second = logger::utility::format_timestamp(base + std::chrono::milliseconds(987));
+
+    EXPECT_EQ(first.substr(0, 20), second.substr(0, 20));
+    EXPECT_EQ(first.substr(20), "000005");
+    EXPECT_EQ(second.substr(20), "000987");
+}
+
+TEST_F(UtilityTest, FormatTimestamp_SecondRollover) {
+    auto base = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+
+    std::string before = logger::utility::format_timestamp(base + std::chrono::milliseconds(999));
+    std::string after = logger::utility::format_timestamp(base + std::chrono::seconds(1));
+
+    EXPECT_NE(before.substr(0, 19), after.substr(0, 19));
+    EXPECT_EQ(after.substr(20), "000000");
+}
+
+TEST_F(UtilityTest, FormatTimestamp_MicrosecondPrecision) {
+    auto base = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    auto timestamp = base + std::chrono::microseconds(123456);
+
+    logger::utility::set_timestamp_precision(logger::utility::TimestampPrecision::MICROSECONDS);
+    std::string micro = logger::utility::format_timestamp(timestamp);
+    logger::utility::set_timestamp_precision(logger::utility::TimestampPrecision::MILLISECONDS);
+    std::string milli = logger::utility::format_timestamp(timestamp);
+
+    EXPECT_EQ(micro.substr(20), "123456");
+    EXPECT_EQ(milli.substr(20), "000123");
+}
@@ -231,3 +231,10 @@ TEST_F(MetricsCollectorTest, ThreadSafety_ConcurrentAddMessages) {
     EXPECT_EQ(stats.messages_by_level.at(logger::LogLevel::ERROR), expected_per_level);
     EXPECT_EQ(stats.messages_by_level.at(logger::LogLevel::FATAL), expected_per_level);
 }
+
+TEST_F(MetricsCollectorTest, AddLostMessages_Accumulates) {
+    collector_->add_lost_messages(5);
+    collector_->add_lost_messages(2);
+    EXPECT_EQ(collector_->get_stats().lost_messages, 7);
+    EXPECT_EQ(collector_->get_stats().total_messages, 0);
+}
@@ -89,6 +89,36 @@ TEST_F(ArgumentParserTest, ParsesSocketModeWithLevel) {
     EXPECT_EQ(config_opt->level, logger::LogLevel::ERROR);
 }
 
+TEST_F(ArgumentParserTest, ParsesUnixSocketMode) {
+    std::vector<std::string> args = {"--socket", "unix:/tmp/logger.sock", "--level", "debug"};
+
+    auto config_opt = ArgumentParser::parse_arguments(args);
+
+    ASSERT_TRUE(config_opt.has_value());
+    EXPECT_EQ(config_opt->mode, AppConfig::Mode::SOCKET);
+    EXPECT_EQ(config_opt->host, "unix:/tmp/logger.sock");
+    EXPECT_EQ(config_opt->port, 0);
+    EXPECT_EQ(config_opt->level, logger::LogLevel::DEBUG);
+}
+
+TEST_F(ArgumentParserTest, ParsesSeqpacketSocketMode) {
+    std::vector<std::string> args = {"--socket", "seqpacket:/tmp/logger.sock"};
+
+    auto config_opt = ArgumentParser::parse_arguments(args);
+
+    ASSERT_TRUE(config_opt.has_value());
+    EXPECT_EQ(config_opt->host, "seqpacket:/tmp/logger.sock");
+    EXPECT_EQ(config_opt->level, logger::LogLevel::INFO);
+}
+
+TEST_F(ArgumentParserTest, UnixSocketModeRejectsPort) {
+    std::vector<std::string> args = {"--socket", "unix:/tmp/logger.sock", "9000"};
+
+    auto config_opt = ArgumentParser::parse_arguments(args);
+
+    EXPECT_FALSE(config_opt.has_value());
+}
+
 TEST_F(ArgumentParserTest, SocketModeMissingHost) {
     std::vector<std::string> args = {"--socket"};
 
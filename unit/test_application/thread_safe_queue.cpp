@@ -0,0 +1,198 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <test_application/log_entry.hpp>
+#include <test_application/thread_safe_queue.hpp>
+
+using namespace test_application;
+
+namespace {
+    logger::QueueOptions make_options(size_t capacity, logger::OverflowPolicy policy) {
+        logger::QueueOptions options(capacity);
+        options.policy = policy;
+        return options;
+    }
+} // namespace
+
+TEST(ThreadSafeQueueTest, DropNewest_RejectsWhenFull) {
+    ThreadSafeQueue<LogEntry> queue(make_options(2, logger::OverflowPolicy::DROP_NEWEST));
+
+    EXPECT_TRUE(queue.push(LogEntry("one", logger::LogLevel::INFO)));
+    EXPECT_TRUE(queue.push(LogEntry("two", logger::LogLevel::INFO)));
+    EXPECT_FALSE(queue.push(LogEntry("three", logger::LogLevel::WARNING)));
+
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::WARNING), 1u);
+}
+
+TEST(ThreadSafeQueueTest, DropNewest_AcceptsErrorWhenFull) {
+    ThreadSafeQueue<LogEntry> queue(make_options(2, logger::OverflowPolicy::DROP_NEWEST));
+
+    queue.push(LogEntry("one", logger::LogLevel::DEBUG));
+    queue.push(LogEntry("two", logger::LogLevel::DEBUG));
+    EXPECT_TRUE(queue.push(LogEntry("error", logger::LogLevel::ERROR)));
+    EXPECT_TRUE(queue.push(LogEntry("fatal", logger::LogLevel::FATAL)));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.drop_counters().total(), 0u);
+}
+
+TEST(ThreadSafeQueueTest, Pop_ServesMostSevereFirst) {
+    ThreadSafeQueue<LogEntry> queue(make_options(8, logger::OverflowPolicy::BLOCK));
+
+    queue.push(LogEntry("debug", logger::LogLevel::DEBUG));
+    queue.push(LogEntry("info", logger::LogLevel::INFO));
+    queue.push(LogEntry("error 1", logger::LogLevel::ERROR));
+    queue.push(LogEntry("error 2", logger::LogLevel::ERROR));
+
+    std::vector<std::string> order;
+    LogEntry entry("", logger::LogLevel::INFO);
+    while (not queue.empty() && queue.pop(entry)) {
+        order.push_back(entry.message);
+    }
+    EXPECT_EQ(order, (std::vector<std::string>{"error 1", "error 2", "info", "debug"}));
+}
+
+TEST(ThreadSafeQueueTest, Pop_LowerLevelNotStarved) {
+    auto options = make_options(64, logger::OverflowPolicy::BLOCK);
+    options.starvation_limit = 3;
+    ThreadSafeQueue<LogEntry> queue(options);
+
+    queue.push(LogEntry("debug", logger::LogLevel::DEBUG));
+    for (int i = 0; i < 10; ++i) {
+        queue.push(LogEntry("error " + std::to_string(i), logger::LogLevel::ERROR));
+    }
+
+    LogEntry entry("", logger::LogLevel::INFO);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(queue.pop(entry));
+        EXPECT_EQ(entry.level, logger::LogLevel::ERROR);
+    }
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.message, "debug");
+}
+
+TEST(ThreadSafeQueueTest, Pop_NoWaitingLaneStarved) {
+    auto options = make_options(64, logger::OverflowPolicy::BLOCK);
+    options.starvation_limit = 3;
+    ThreadSafeQueue<LogEntry> queue(options);
+
+    for (int i = 0; i < 20; ++i) {
+        queue.push(LogEntry("error", logger::LogLevel::ERROR));
+        queue.push(LogEntry("warning", logger::LogLevel::WARNING));
+        queue.push(LogEntry("debug", logger::LogLevel::DEBUG));
+    }
+
+    // Every waiting lane is served at least once in any run of starvation_limit + lane count pops
+    std::vector<logger::LogLevel> order;
+    LogEntry entry("", logger::LogLevel::INFO);
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_TRUE(queue.pop(entry));
+        order.push_back(entry.level);
+    }
+    for (auto level: {logger::LogLevel::ERROR, logger::LogLevel::WARNING, logger::LogLevel::DEBUG}) {
+        size_t since_served = 0;
+        for (auto popped: order) {
+            since_served = popped == level ? 0 : since_served + 1;
+            EXPECT_LE(since_served, 3u + 2u) << static_cast<int>(level);
+        }
+    }
+}
+
+TEST(ThreadSafeQueueTest, DropOldest_NeverEvictsMoreSevereItems) {
+    ThreadSafeQueue<LogEntry> queue(make_options(2, logger::OverflowPolicy::DROP_OLDEST));
+
+    queue.push(LogEntry("warning 1", logger::LogLevel::WARNING));
+    queue.push(LogEntry("warning 2", logger::LogLevel::WARNING));
+    EXPECT_FALSE(queue.push(LogEntry("debug", logger::LogLevel::DEBUG)));
+
+    LogEntry entry("", logger::LogLevel::INFO);
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.message, "warning 1");
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::DEBUG), 1u);
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::WARNING), 0u);
+}
+
+TEST(ThreadSafeQueueTest, DropOldest_NeverEvictsProtectedLevels) {
+    ThreadSafeQueue<LogEntry> queue(make_options(2, logger::OverflowPolicy::DROP_OLDEST));
+
+    queue.push(LogEntry("error 1", logger::LogLevel::ERROR));
+    queue.push(LogEntry("error 2", logger::LogLevel::ERROR));
+    EXPECT_FALSE(queue.push(LogEntry("info", logger::LogLevel::INFO)));
+
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::INFO), 1u);
+}
+
+TEST(ThreadSafeQueueTest, DropOldest_EvictsFront) {
+    ThreadSafeQueue<LogEntry> queue(make_options(2, logger::OverflowPolicy::DROP_OLDEST));
+
+    queue.push(LogEntry("one", logger::LogLevel::DEBUG));
+    queue.push(LogEntry("two", logger::LogLevel::INFO));
+    EXPECT_TRUE(queue.push(LogEntry("three", logger::LogLevel::INFO)));
+
+    LogEntry entry("", logger::LogLevel::INFO);
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.message, "two");
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::DEBUG), 1u);
+}
+
+TEST(ThreadSafeQueueTest, Block_WaitsForRoom) {
+    ThreadSafeQueue<LogEntry> queue(make_options(1, logger::OverflowPolicy::BLOCK));
+    queue.push(LogEntry("one", logger::LogLevel::INFO));
+
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        LogEntry entry("", logger::LogLevel::INFO);
+        queue.pop(entry);
+    });
+
+    EXPECT_TRUE(queue.push(LogEntry("two", logger::LogLevel::INFO)));
+    consumer.join();
+    EXPECT_EQ(queue.drop_counters().total(), 0u);
+}
+
+TEST(ThreadSafeQueueTest, BlockWithTimeout_DropsBelowLevelImmediately) {
+    auto options = make_options(1, logger::OverflowPolicy::BLOCK);
+    options.block_timeout = std::chrono::milliseconds(10);
+    options.drop_below = logger::LogLevel::INFO;
+    ThreadSafeQueue<LogEntry> queue(options);
+
+    queue.push(LogEntry("one", logger::LogLevel::INFO));
+    EXPECT_FALSE(queue.push(LogEntry("debug", logger::LogLevel::DEBUG)));
+    EXPECT_FALSE(queue.push(LogEntry("warning", logger::LogLevel::WARNING)));
+
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::DEBUG), 1u);
+    EXPECT_EQ(queue.drop_counters().count(logger::LogLevel::WARNING), 1u);
+}
+
+TEST(ThreadSafeQueueTest, WaitUntilDone_ReturnsAfterConsumerFinished) {
+    ThreadSafeQueue<LogEntry> queue;
+    std::atomic<int> written{0};
+
+    std::thread consumer([&] {
+        LogEntry entry("", logger::LogLevel::INFO);
+        while (queue.pop(entry)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++written;
+            queue.task_done();
+        }
+    });
+
+    for (int i = 0; i < 20; ++i) {
+        queue.push(LogEntry("message", logger::LogLevel::INFO));
+    }
+    queue.push(LogEntry("fatal", logger::LogLevel::FATAL));
+
+    queue.wait_until_done();
+    EXPECT_EQ(written.load(), 21);
+
+    queue.stop();
+    consumer.join();
+}